@@ -0,0 +1,145 @@
+/**************************************************************************//**
+ *
+ * @file adafruit-ssd1306.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code for the headless stand-in for the Adafruit_SSD1306 display
+ *      driver.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <Adafruit_SSD1306.h>
+#include "host-hal.h"
+
+#define CHARACTER_WIDTH     (6)
+#define CHARACTER_HEIGHT    (8)
+
+// what the panel shows, as of the last call to display()
+static uint8_t panel[HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT / 8];
+static char panel_text[HOST_DISPLAY_TEXT_ROWS][HOST_DISPLAY_TEXT_COLUMNS + 1];
+static uint32_t refreshes = 0;
+static bool echo = false;
+static uint32_t flush_us = 0;
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t width, uint8_t height) : text_size(1), cursor_x(0), cursor_y(0) {
+    clearDisplay();
+}
+
+bool Adafruit_SSD1306::begin(uint8_t switchvcc, uint8_t i2caddr, bool reset, bool periphBegin) {
+    clearDisplay();
+    return true;
+}
+
+void Adafruit_SSD1306::clearDisplay(void) {
+    memset(buffer, 0, sizeof(buffer));
+    memset(text, 0, sizeof(text));
+}
+
+void Adafruit_SSD1306::display(void) {
+    // the I2C transfer holds the CPU on the RP2040 too
+    if (flush_us > 0) {
+        advance_host_time(flush_us);
+    }
+    bool text_changed = memcmp(panel_text, text, sizeof(text)) != 0;
+    memcpy(panel, buffer, sizeof(buffer));
+    memcpy(panel_text, text, sizeof(text));
+    refreshes++;
+    if (echo && text_changed) {
+        fprintf(stderr, "+---------------------+\n");
+        for (int row = 0; row < HOST_DISPLAY_TEXT_ROWS; row++) {
+            fprintf(stderr, "|%-21s|\n", panel_text[row]);
+        }
+        fprintf(stderr, "+---------------------+\n");
+    }
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || x >= HOST_DISPLAY_WIDTH || y < 0 || y >= HOST_DISPLAY_HEIGHT) {
+        return;
+    }
+    uint8_t *byte = &buffer[x + (y / 8) * HOST_DISPLAY_WIDTH];
+    uint8_t mask = (uint8_t) (1 << (y & 7));
+    switch (color) {
+        case SSD1306_WHITE:
+            *byte |= mask;
+            break;
+        case SSD1306_BLACK:
+            *byte &= (uint8_t) ~mask;
+            break;
+        case SSD1306_INVERSE:
+            *byte ^= mask;
+            break;
+    }
+}
+
+void Adafruit_SSD1306::drawBitmap(int16_t x, int16_t y, uint8_t const bitmap[], int16_t w, int16_t h,
+                                  uint16_t color) {
+    int16_t bytes_per_row = (int16_t) ((w + 7) / 8);
+    for (int16_t j = 0; j < h; j++) {
+        for (int16_t i = 0; i < w; i++) {
+            if (bitmap[j * bytes_per_row + i / 8] & (0x80 >> (i & 7))) {
+                drawPixel((int16_t) (x + i), (int16_t) (y + j), color);
+            }
+        }
+    }
+}
+
+void Adafruit_SSD1306::setTextSize(uint8_t size) {
+    text_size = size ? size : 1;
+}
+
+void Adafruit_SSD1306::setTextColor(uint16_t color) {}
+
+void Adafruit_SSD1306::setCursor(int16_t x, int16_t y) {
+    cursor_x = x;
+    cursor_y = y;
+}
+
+size_t Adafruit_SSD1306::print(char const *string) {
+    int row = cursor_y / (CHARACTER_HEIGHT * text_size);
+    int column = cursor_x / (CHARACTER_WIDTH * text_size);
+    size_t length = strlen(string);
+    for (size_t i = 0; i < length && row < HOST_DISPLAY_TEXT_ROWS; i++) {
+        if (string[i] == '\n') {
+            row++;
+            column = 0;
+        } else if (column < HOST_DISPLAY_TEXT_COLUMNS) {
+            text[row][column++] = string[i];
+        }
+    }
+    cursor_x = (int16_t) (column * CHARACTER_WIDTH * text_size);
+    cursor_y = (int16_t) (row * CHARACTER_HEIGHT * text_size);
+    return length;
+}
+
+uint8_t *Adafruit_SSD1306::getBuffer(void) {
+    return buffer;
+}
+
+extern "C" {
+
+char const *get_host_display_row(int row) {
+    return (0 <= row && row < HOST_DISPLAY_TEXT_ROWS) ? panel_text[row] : "";
+}
+
+uint32_t get_host_display_refreshes(void) {
+    return refreshes;
+}
+
+void set_host_display_echo(bool enabled) {
+    echo = enabled;
+}
+
+void set_host_display_flush_time(uint32_t microseconds) {
+    flush_us = microseconds;
+}
+
+} // extern "C"
@@ -0,0 +1,79 @@
+/**************************************************************************//**
+ *
+ * @file bench-timer.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to time the host benches' operations and count their
+ *      instructions with a perf event.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "bench-timer.h"
+#include "host-hal.h"
+
+#define NOT_OPENED  (-2)
+
+static int instruction_counter = NOT_OPENED;
+
+// -1 if the kernel does not allow it, as in most containers
+static void open_instruction_counter(void) {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    instruction_counter = (int) syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+static uint64_t read_instruction_counter(void) {
+    uint64_t count = 0;
+    if (read(instruction_counter, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+    }
+    return count;
+}
+
+bench_timing_t time_operation(void (*operation)(void), int operations, int runs) {
+    bench_timing_t timing;
+    uint32_t best_ns = UINT32_MAX;
+    if (instruction_counter == NOT_OPENED) {
+        open_instruction_counter();
+    }
+    for (int run = 0; run < runs; run++) {
+        uint32_t start = get_host_clock_ns();
+        for (int i = 0; i < operations; i++) {
+            operation();
+        }
+        uint32_t elapsed = get_host_clock_ns() - start;
+        if (elapsed < best_ns) {
+            best_ns = elapsed;
+        }
+    }
+    timing.ns_per_op = (double) best_ns / operations;
+    timing.instructions_per_op = -1;
+    if (instruction_counter >= 0) {
+        ioctl(instruction_counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(instruction_counter, PERF_EVENT_IOC_ENABLE, 0);
+        for (int i = 0; i < operations; i++) {
+            operation();
+        }
+        ioctl(instruction_counter, PERF_EVENT_IOC_DISABLE, 0);
+        timing.instructions_per_op = (double) read_instruction_counter() / operations;
+    }
+    return timing;
+}
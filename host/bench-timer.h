@@ -0,0 +1,41 @@
+/**************************************************************************//**
+ *
+ * @file bench-timer.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Times an operation for the host benches: the fastest of several
+ *      runs on the host's monotonic clock and, where the kernel allows
+ *      hardware counters, the instructions it executes.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_BENCH_TIMER_H
+#define COMBOLOCK_BENCH_TIMER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    double ns_per_op;
+    double instructions_per_op;     // negative if unavailable
+} bench_timing_t;
+
+/**
+ * Calls `operation` `operations` times in each of `runs` runs and keeps the
+ * fastest run; the instructions are counted over one more run.
+ */
+bench_timing_t time_operation(void (*operation)(void), int operations, int runs);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_BENCH_TIMER_H
@@ -0,0 +1,44 @@
+/**************************************************************************//**
+ *
+ * @file console-stdin.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Stands in for the console's Serial port with standard input, read
+ *      without blocking.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <poll.h>
+#include <unistd.h>
+#include "console.h"
+
+static bool end_of_input = false;
+
+static int stdin_read(void) {
+    struct pollfd descriptor = {.fd = STDIN_FILENO, .events = POLLIN};
+    unsigned char byte;
+    if (end_of_input || poll(&descriptor, 1, 0) <= 0) {
+        return -1;
+    }
+    if (read(STDIN_FILENO, &byte, 1) != 1) {
+        end_of_input = true;
+        return -1;
+    }
+    return byte;
+}
+
+static console_port_t const stdin_port = {
+        .read = stdin_read,
+};
+
+console_port_t const *get_console_port(void) {
+    return &stdin_port;
+}
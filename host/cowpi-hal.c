@@ -0,0 +1,367 @@
+/**************************************************************************//**
+ *
+ * @file cowpi-hal.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to stand in for the CowPi hardware on a Linux host: the
+ *      library's input and LED calls, the memory-mapped SIO block and timer,
+ *      and the interrupt_support functions.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#define _GNU_SOURCE
+
+#include <CowPi.h>
+#include <sys/mman.h>
+#include <time.h>
+#include "host-hal.h"
+#include "interrupt_support.h"
+#include "registers.h"
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE     (0x100000)
+#endif
+
+#define REGISTER_BLOCK_SIZE     (4096)
+#define A_WIPER_PIN             (16)
+#define B_WIPER_PIN             (17)
+#define NUMBER_OF_PINS          (32)
+
+/* A period of 0 marks a one-shot timer, which is disarmed as it fires. */
+typedef struct {
+    uint32_t period_us;
+    uint64_t deadline_us;
+    void (*isr)(void);
+} host_timer_t;
+
+static bool initialized = false;
+static cowpi_ioport_t volatile *ioport;
+static cowpi_timer_t volatile *timer;
+static struct timespec start_time;
+static bool virtual_time = false;
+static uint64_t virtual_now_us = 0;
+static host_timer_t timers[MAXIMUM_NUMBER_OF_TIMERS];
+static host_timer_t one_shot_timers[MAXIMUM_NUMBER_OF_TIMERS];
+static void (*pin_isrs[NUMBER_OF_PINS])(void);
+static uint64_t interrupt_count = 0;
+static bool interrupts_masked = false;
+static uint32_t pending_pins = 0;
+
+static bool buttons[2];
+static bool switches_in_right_position[2];
+static char key = '\0';
+static bool leds[2];
+
+static void *map_register_block(uintptr_t address) {
+    void *block = mmap((void *) address, REGISTER_BLOCK_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (block != (void *) address) {
+        fprintf(stderr, "cannot map the register block at 0x%08lx\n", (unsigned long) address);
+        exit(1);
+    }
+    return block;
+}
+
+void initialize_host_hal(void) {
+    if (initialized) {
+        return;
+    }
+    ioport = (cowpi_ioport_t *) map_register_block(SIO_BASE);
+    timer = (cowpi_timer_t *) map_register_block(TIMER_BASE);
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+    initialized = true;
+}
+
+uint64_t get_host_time_us(void) {
+    if (virtual_time) {
+        return virtual_now_us;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) (now.tv_sec - start_time.tv_sec) * 1000000
+           + (now.tv_nsec - start_time.tv_nsec) / 1000;
+}
+
+uint32_t get_host_clock_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) (now.tv_sec - start_time.tv_sec) * 1000000000 + now.tv_nsec - start_time.tv_nsec);
+}
+
+static uint64_t update_timer_registers(void) {
+    uint64_t now = get_host_time_us();
+    timer->raw_upper_word = (uint32_t) (now >> 32);
+    timer->raw_lower_word = (uint32_t) now;
+    timer->read_upper_word = timer->raw_upper_word;
+    timer->read_lower_word = timer->raw_lower_word;
+    return now;
+}
+
+static void service_timer(host_timer_t *host_timer, uint64_t now) {
+    while (host_timer->isr != NULL && now >= host_timer->deadline_us) {
+        void (*isr)(void) = host_timer->isr;
+        if (host_timer->period_us == 0) {
+            host_timer->isr = NULL;
+        }
+        host_timer->deadline_us += host_timer->period_us;
+        isr();
+        interrupt_count++;
+    }
+}
+
+void service_host_timers(void) {
+    uint64_t now = update_timer_registers();
+    for (int i = 0; i < MAXIMUM_NUMBER_OF_TIMERS; i++) {
+        service_timer(&timers[i], now);
+        service_timer(&one_shot_timers[i], now);
+    }
+}
+
+static uint64_t get_next_deadline(uint64_t now) {
+    uint64_t deadline = UINT64_MAX;
+    for (int i = 0; i < MAXIMUM_NUMBER_OF_TIMERS; i++) {
+        if (timers[i].isr != NULL && timers[i].deadline_us < deadline) {
+            deadline = timers[i].deadline_us;
+        }
+        if (one_shot_timers[i].isr != NULL && one_shot_timers[i].deadline_us < deadline) {
+            deadline = one_shot_timers[i].deadline_us;
+        }
+    }
+    return (deadline == UINT64_MAX) ? now + 1000 : deadline;
+}
+
+void use_host_virtual_time(void) {
+    virtual_now_us = get_host_time_us();
+    virtual_time = true;
+}
+
+bool host_time_is_virtual(void) {
+    return virtual_time;
+}
+
+void advance_host_time(uint64_t microseconds) {
+    uint64_t end = get_host_time_us() + microseconds;
+    if (!virtual_time) {
+        while (get_host_time_us() < end) {}
+        return;
+    }
+    uint64_t deadline;
+    while ((deadline = get_next_deadline(virtual_now_us)) <= end) {
+        virtual_now_us = (deadline > virtual_now_us) ? deadline : virtual_now_us;
+        service_host_timers();
+    }
+    virtual_now_us = end;
+    service_host_timers();
+}
+
+void advance_host_time_to_next_timer(void) {
+    if (virtual_time) {
+        uint64_t deadline = get_next_deadline(virtual_now_us);
+        virtual_now_us = (deadline > virtual_now_us) ? deadline : virtual_now_us;
+    }
+    service_host_timers();
+}
+
+void wait_for_host_interrupt(void) {
+    uint64_t now = get_host_time_us();
+    uint64_t deadline = get_next_deadline(now);
+    if (virtual_time) {
+        advance_host_time_to_next_timer();
+        return;
+    }
+    if (deadline > now) {
+        struct timespec pause = {.tv_sec = (time_t) ((deadline - now) / 1000000),
+                                 .tv_nsec = (long) ((deadline - now) % 1000000) * 1000};
+        nanosleep(&pause, NULL);
+    }
+    service_host_timers();
+}
+
+uint64_t get_host_interrupt_count(void) {
+    return interrupt_count;
+}
+
+static void set_pin(unsigned int pin, bool level) {
+    uint32_t mask = 1u << pin;
+    if (!(ioport->input & mask) == !level) {
+        return;
+    }
+    ioport->input ^= mask;
+    if (pin_isrs[pin] == NULL) {
+        return;
+    }
+    if (interrupts_masked) {
+        pending_pins |= mask;
+    } else {
+        pin_isrs[pin]();
+        interrupt_count++;
+    }
+}
+
+void toggle_host_pin(unsigned int pin) {
+    set_pin(pin, !(ioport->input & (1u << pin)));
+}
+
+void set_host_button(host_side_t button, bool pressed) {
+    buttons[button] = pressed;
+}
+
+void set_host_switch(host_side_t slide_switch, bool in_right_position) {
+    switches_in_right_position[slide_switch] = in_right_position;
+}
+
+void set_host_key(char pressed_key) {
+    key = pressed_key;
+}
+
+void turn_host_dial(direction_t direction) {
+    if (direction == STATIONARY) {
+        return;
+    }
+    // clockwise, the quadrature goes 11, 10, 00, 01, 11 (B wiper in the high bit)
+    unsigned int first = (direction == CLOCKWISE) ? A_WIPER_PIN : B_WIPER_PIN;
+    unsigned int second = (direction == CLOCKWISE) ? B_WIPER_PIN : A_WIPER_PIN;
+    set_pin(first, false);
+    set_pin(second, false);
+    set_pin(first, true);
+    set_pin(second, true);
+}
+
+bool host_led_is_lit(host_side_t led) {
+    return leds[led];
+}
+
+void cowpi_setup(unsigned int configuration, cowpi_display_module_t display_module,
+                 cowpi_display_module_protocol_t display_protocol) {
+    initialize_host_hal();
+}
+
+void cowpi_set_output_pins(uint32_t pin_mask) {
+    ioport->output_enable |= pin_mask;
+}
+
+void cowpi_set_pullup_input_pins(uint32_t pin_mask) {
+    ioport->output_enable &= ~pin_mask;
+    ioport->input |= pin_mask;
+}
+
+bool cowpi_left_button_is_pressed(void) {
+    return buttons[HOST_LEFT];
+}
+
+bool cowpi_right_button_is_pressed(void) {
+    return buttons[HOST_RIGHT];
+}
+
+bool cowpi_left_switch_is_in_left_position(void) {
+    return !switches_in_right_position[HOST_LEFT];
+}
+
+bool cowpi_left_switch_is_in_right_position(void) {
+    return switches_in_right_position[HOST_LEFT];
+}
+
+bool cowpi_right_switch_is_in_left_position(void) {
+    return !switches_in_right_position[HOST_RIGHT];
+}
+
+bool cowpi_right_switch_is_in_right_position(void) {
+    return switches_in_right_position[HOST_RIGHT];
+}
+
+char cowpi_get_keypress(void) {
+    return key;
+}
+
+void cowpi_illuminate_left_led(void) {
+    leds[HOST_LEFT] = true;
+}
+
+void cowpi_deluminate_left_led(void) {
+    leds[HOST_LEFT] = false;
+}
+
+void cowpi_illuminate_right_led(void) {
+    leds[HOST_RIGHT] = true;
+}
+
+void cowpi_deluminate_right_led(void) {
+    leds[HOST_RIGHT] = false;
+}
+
+unsigned long millis(void) {
+    return (unsigned long) (get_host_time_us() / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long) get_host_time_us();
+}
+
+void delay(unsigned long ms) {
+    if (virtual_time) {
+        advance_host_time(1000 * (uint64_t) ms);
+        return;
+    }
+    uint64_t end = get_host_time_us() + 1000 * (uint64_t) ms;
+    while (get_host_time_us() < end) {
+        service_host_timers();
+    }
+}
+
+// periodic ISRs never preempt the main loop on the host, but a pin change
+// made while interrupts are masked is held until they are unmasked, once
+void noInterrupts(void) {
+    interrupts_masked = true;
+}
+
+void interrupts(void) {
+    interrupts_masked = false;
+    for (unsigned int pin = 0; pending_pins != 0; pin++) {
+        if (pending_pins & (1u << pin)) {
+            pending_pins &= ~(1u << pin);
+            pin_isrs[pin]();
+            interrupt_count++;
+        }
+    }
+}
+
+void register_pin_ISR(uint32_t interrupt_mask, void (*isr)(void)) {
+    for (unsigned int pin = 0; pin < NUMBER_OF_PINS; pin++) {
+        if (interrupt_mask & (1u << pin)) {
+            pin_isrs[pin] = isr;
+        }
+    }
+}
+
+bool register_periodic_timer_ISR(unsigned int timer_number, uint32_t period_us, void (*isr)(void)) {
+    if (timer_number >= MAXIMUM_NUMBER_OF_TIMERS || period_us == 0) {
+        return false;
+    }
+    timers[timer_number].period_us = period_us;
+    timers[timer_number].deadline_us = get_host_time_us() + period_us;
+    timers[timer_number].isr = isr;
+    return true;
+}
+
+void reset_periodic_timer(unsigned int timer_number) {
+    if (timer_number < MAXIMUM_NUMBER_OF_TIMERS) {
+        timers[timer_number].deadline_us = get_host_time_us() + timers[timer_number].period_us;
+    }
+}
+
+bool register_one_shot_timer_ISR(unsigned int timer_number, uint32_t delay_us, void (*isr)(void)) {
+    if (timer_number >= MAXIMUM_NUMBER_OF_TIMERS) {
+        return false;
+    }
+    one_shot_timers[timer_number].period_us = 0;
+    one_shot_timers[timer_number].deadline_us = get_host_time_us() + delay_us;
+    one_shot_timers[timer_number].isr = isr;
+    return true;
+}
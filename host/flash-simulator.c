@@ -0,0 +1,119 @@
+/**************************************************************************//**
+ *
+ * @file flash-simulator.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to simulate NOR flash for the settings store.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <string.h>
+#include "flash-simulator.h"
+
+#define PAGE_SIZE           (256)
+#define SECTOR_SIZE         (4096)
+#define NUMBER_OF_SECTORS   (16)
+
+static uint8_t memory[NUMBER_OF_SECTORS * SECTOR_SIZE];
+static uint32_t erase_counts[NUMBER_OF_SECTORS];
+static uint32_t operations_until_power_cut = 0;
+static uint32_t bytes_before_power_cut = 0;
+static bool power_cut = false;
+static bool initialized = false;
+
+/* Returns true if this operation is the one that loses power. */
+static bool power_fails_now(void) {
+    if (operations_until_power_cut && --operations_until_power_cut == 0) {
+        power_cut = true;
+        return true;
+    }
+    return false;
+}
+
+static int read_flash(uint32_t offset, void *buffer, uint32_t length) {
+    if (offset + length > sizeof(memory)) {
+        return -1;
+    }
+    memcpy(buffer, memory + offset, length);
+    return 0;
+}
+
+static int program_flash(uint32_t offset, void const *page) {
+    if (power_cut || offset % PAGE_SIZE || offset + PAGE_SIZE > sizeof(memory)) {
+        return -1;
+    }
+    uint8_t const *bytes = (uint8_t const *) page;
+    uint32_t length = PAGE_SIZE;
+    if (power_fails_now()) {
+        // bytes are programmed in order, so the cut leaves a prefix of the record, counted from its first byte
+        uint32_t first = 0;
+        while (first < PAGE_SIZE && bytes[first] == 0xFF) {
+            first++;
+        }
+        length = (first + bytes_before_power_cut < PAGE_SIZE) ? first + bytes_before_power_cut : PAGE_SIZE;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        memory[offset + i] &= bytes[i];
+    }
+    return power_cut ? -1 : 0;
+}
+
+static int erase_flash(uint32_t offset) {
+    if (power_cut || offset % SECTOR_SIZE || offset + SECTOR_SIZE > sizeof(memory)) {
+        return -1;
+    }
+    uint32_t length = power_fails_now() ? SECTOR_SIZE / 3 : SECTOR_SIZE;
+    memset(memory + offset, 0xFF, length);
+    erase_counts[offset / SECTOR_SIZE]++;
+    return power_cut ? -1 : 0;
+}
+
+static flash_device_t const device = {
+        .page_size = PAGE_SIZE,
+        .sector_size = SECTOR_SIZE,
+        .number_of_sectors = NUMBER_OF_SECTORS,
+        .read = read_flash,
+        .program = program_flash,
+        .erase = erase_flash,
+};
+
+flash_device_t const *get_flash_device(void) {
+    if (!initialized) {
+        reset_flash_simulator();
+    }
+    return &device;
+}
+
+void reset_flash_simulator(void) {
+    memset(memory, 0xFF, sizeof(memory));
+    memset(erase_counts, 0, sizeof(erase_counts));
+    operations_until_power_cut = 0;
+    bytes_before_power_cut = 0;
+    power_cut = false;
+    initialized = true;
+}
+
+void cut_power_after(uint32_t operations, uint32_t bytes_programmed) {
+    operations_until_power_cut = operations;
+    bytes_before_power_cut = bytes_programmed;
+}
+
+void restore_power(void) {
+    operations_until_power_cut = 0;
+    power_cut = false;
+}
+
+bool power_is_cut(void) {
+    return power_cut;
+}
+
+uint32_t get_sector_erase_count(uint32_t sector) {
+    return (sector < NUMBER_OF_SECTORS) ? erase_counts[sector] : 0;
+}
@@ -0,0 +1,67 @@
+/**************************************************************************//**
+ *
+ * @file flash-simulator.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A RAM-backed stand-in for NOR flash, for running the settings store
+ *      off-device, with power-cut fault injection.
+ *
+ * Programming can only clear bits, as on real NOR flash. When a power cut is
+ * scheduled, the operation that hits it is left half-done (a record
+ * programmed only up to a given byte, or a partially-erased sector) and
+ * every later operation fails until power is restored.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_FLASH_SIMULATOR_H
+#define COMBOLOCK_FLASH_SIMULATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "settings-store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Erases the simulated flash and resets its counters.
+ */
+void reset_flash_simulator(void);
+
+/**
+ * Schedules a power cut during the `operations`-th program or erase from now
+ * (1 is the very next one). If that operation is a program, only the first
+ * `bytes_programmed` bytes of what it writes, counted from the first byte
+ * that is not 0xFF, reach flash; an erase is left a third done.
+ */
+void cut_power_after(uint32_t operations, uint32_t bytes_programmed);
+
+/**
+ * Allows program and erase operations to succeed again after a power cut.
+ */
+void restore_power(void);
+
+/**
+ * @return <code>true</code> if a scheduled power cut has happened and power
+ *      has not been restored
+ */
+bool power_is_cut(void);
+
+/**
+ * @return The number of times the given sector has been erased
+ */
+uint32_t get_sector_erase_count(uint32_t sector);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_FLASH_SIMULATOR_H
@@ -0,0 +1,649 @@
+/**************************************************************************//**
+ *
+ * @file fleet.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Runs thousands of independent lock instances on every core, each
+ *      driven by a simulated person with a randomized script, and checks
+ *      each lock against a model of what the person should have seen.
+ *      Reports aggregate events/s and the latency of each event.
+ *
+ * Usage: <code>fleet [-l locks] [-s steps] [-j threads] [-r seed] [-n]</code>
+ * <ul>
+ * <li> <code>-l</code> the number of locks (4096 by default)
+ * <li> <code>-s</code> the control_lock_instance() calls per lock (2000 by
+ *      default); each call is one event
+ * <li> <code>-j</code> the number of threads (one per online core by
+ *      default); each owns an equal share of the locks
+ * <li> <code>-r</code> the random seed, so that a divergence can be replayed
+ * <li> <code>-n</code> leaves out the display callback, which skips
+ *      formatting the display
+ * </ul>
+ *
+ * The person dials the right combination or a random one and presses the
+ * left button, relocks, changes the combination (sometimes with a typo),
+ * turns the dial and presses keys when it should not matter, power-cycles
+ * the lock, and has an alarmed lock reset. After each script the lock's
+ * state, bad tries, stored settings and top display row must agree with
+ * the model, which dials one detent at a time rather than through the
+ * combination engine. The process exits with status 1 if any lock diverged.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "lock-instance.h"
+
+#define DEFAULT_LOCKS                   (4096)
+#define DEFAULT_STEPS                   (2000)
+#define MAXIMUM_DETENTS_PER_STEP        (8)
+#define MAXIMUM_STEPS_PER_TURN          (8)
+#define MAXIMUM_SCRIPT_LENGTH           (MAXIMUM_STEPS_PER_TURN * COMBINATION_LENGTH + NEW_COMBINATION_LENGTH)
+#define LATENCY_BUCKET_NS               (4)
+#define NUMBER_OF_LATENCY_BUCKETS       (4096)
+#define MAXIMUM_REPORTED_DIVERGENCES    (10)
+#define DISPLAY_ROWS                    (4)
+#define DISPLAY_COLUMNS                 (22)
+
+static uint8_t const required_passes[COMBINATION_LENGTH] = {COMBOLOCK_REQUIRED_PASSES};
+
+/* One step of a script: the input that is waiting when control_lock_instance()
+ * runs. A pushbutton or switch event is made whenever a level changes. */
+typedef struct {
+    int8_t detents;
+    uint8_t levels;                 // bit per input_t
+    uint8_t number_of_keys;
+    char keys[2];                   // each is pressed and released
+    enum { NO_RESET, POWER_CYCLE, TECHNICIAN_RESET } reset;
+} stimulus_t;
+
+typedef struct {
+    lock_state_t state;
+    int bad_tries;
+    uint8_t combination[COMBINATION_LENGTH];
+} expectation_t;
+
+typedef struct {
+    lock_instance_t lock;
+    uint32_t random;
+    // this step's input
+    int detents;
+    uint8_t levels;
+    input_event_t input_events[NUMBER_OF_INPUTS];
+    uint8_t number_of_input_events;
+    uint8_t next_input_event;
+    keypad_event_t key_events[4];
+    uint8_t number_of_key_events;
+    uint8_t next_key_event;
+    // the output
+    lock_pattern_t pattern;
+    uint8_t stored_combination[COMBINATION_LENGTH];
+    uint8_t stored_bad_tries;
+    char display[DISPLAY_ROWS][DISPLAY_COLUMNS];
+    // the script being played, and what it should leave behind
+    stimulus_t script[MAXIMUM_SCRIPT_LENGTH];
+    uint8_t script_length;
+    uint8_t script_step;
+    expectation_t expected;
+    // what happened
+    uint32_t unlocks;
+    uint32_t alarms;
+    uint32_t bad_tries;
+    uint32_t combination_changes;
+    uint32_t resets;
+    uint32_t scripts;
+} simulated_lock_t;
+
+typedef struct {
+    simulated_lock_t *locks;
+    unsigned number_of_locks;
+    unsigned steps;
+    unsigned index;
+    // measurements
+    uint64_t latency_buckets[NUMBER_OF_LATENCY_BUCKETS];
+    uint64_t longest_ns;
+    uint64_t events_by_state[NUMBER_OF_LOCK_STATES];
+    uint64_t ns_by_state[NUMBER_OF_LOCK_STATES];
+    uint64_t divergences;
+} fleet_thread_t;
+
+static pthread_mutex_t report_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t reported_divergences = 0;
+
+static uint32_t next_random(simulated_lock_t *sim) {
+    // xorshift32
+    uint32_t x = sim->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sim->random = x;
+    return x;
+}
+
+static uint32_t random_below(simulated_lock_t *sim, uint32_t limit) {
+    return next_random(sim) % limit;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+/* The lock's callbacks */
+
+static int take_simulated_detents(void *context) {
+    simulated_lock_t *sim = context;
+    int detents = sim->detents;
+    sim->detents = 0;
+    return detents;
+}
+
+static bool take_simulated_input_event(void *context, input_event_t *event) {
+    simulated_lock_t *sim = context;
+    if (sim->next_input_event == sim->number_of_input_events) {
+        return false;
+    }
+    *event = sim->input_events[sim->next_input_event++];
+    return true;
+}
+
+static bool take_simulated_key_event(void *context, keypad_event_t *event) {
+    simulated_lock_t *sim = context;
+    if (sim->next_key_event == sim->number_of_key_events) {
+        return false;
+    }
+    *event = sim->key_events[sim->next_key_event++];
+    return true;
+}
+
+static bool simulated_input_is_pressed(void *context, input_t input) {
+    simulated_lock_t *sim = context;
+    return sim->levels & (1 << input);
+}
+
+static bool simulated_pattern_is_active(void *context) {
+    simulated_lock_t *sim = context;
+    // a bad-try pattern is taken to have finished by the next step
+    return sim->pattern == LOCK_PATTERN_ALARM;
+}
+
+static void show_simulated_pattern(void *context, lock_pattern_t pattern) {
+    simulated_lock_t *sim = context;
+    sim->pattern = pattern;
+}
+
+static void show_simulated_string(void *context, int row, char const *text) {
+    simulated_lock_t *sim = context;
+    strncpy(sim->display[row], text, DISPLAY_COLUMNS - 1);
+}
+
+static void store_combination(void *context, uint8_t const combination[]) {
+    simulated_lock_t *sim = context;
+    memcpy(sim->stored_combination, combination, COMBINATION_LENGTH);
+    sim->combination_changes++;
+}
+
+static void store_bad_tries(void *context, uint8_t bad_tries) {
+    simulated_lock_t *sim = context;
+    sim->stored_bad_tries = bad_tries;
+    if (bad_tries > 0) {
+        sim->bad_tries++;
+    }
+}
+
+static void count_state_change(void *context, lock_state_t from, lock_state_t to, int bad_tries) {
+    simulated_lock_t *sim = context;
+    sim->unlocks += (to == UNLOCKED && from == LOCKED);
+    sim->alarms += (to == ALARMED);
+}
+
+static lock_io_t fleet_io = {
+        .take_detent_delta = take_simulated_detents,
+        .get_input_event = take_simulated_input_event,
+        .get_keypad_event = take_simulated_key_event,
+        .input_is_pressed = simulated_input_is_pressed,
+        .pattern_is_active = simulated_pattern_is_active,
+        .show_pattern = show_simulated_pattern,
+        .display_string = show_simulated_string,
+        .save_combination = store_combination,
+        .save_bad_tries = store_bad_tries,
+        .change_state = count_state_change,
+};
+
+/* The model */
+
+static unsigned detents_to(uint8_t from, uint8_t to, bool clockwise) {
+    unsigned distance = clockwise ? (unsigned) (to + COMBOLOCK_DIAL_POSITIONS - from) % COMBOLOCK_DIAL_POSITIONS
+                                  : (unsigned) (from + COMBOLOCK_DIAL_POSITIONS - to) % COMBOLOCK_DIAL_POSITIONS;
+    return (distance == 0) ? COMBOLOCK_DIAL_POSITIONS : distance;
+}
+
+/* Whether turning the dial `turns[i]` detents for each number in turn,
+ * alternately clockwise and counterclockwise from a cleared entry, opens the
+ * lock. The first detent of each turn after the first only moves on to the
+ * next number. */
+static bool dialing_opens(unsigned const turns[], uint8_t const combination[]) {
+    unsigned position = 0;
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        bool clockwise = (i % 2 == 0);
+        unsigned passes = 0;
+        for (unsigned detent = (i == 0) ? 0 : 1; detent < turns[i]; detent++) {
+            position = (position + (clockwise ? 1 : COMBOLOCK_DIAL_POSITIONS - 1)) % COMBOLOCK_DIAL_POSITIONS;
+            passes += (position == combination[i]);
+        }
+        if (position != combination[i]) {
+            return false;
+        }
+        if ((i == 0) ? (passes < required_passes[i]) : (passes != required_passes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool new_combination_is_valid(uint8_t const numbers[]) {
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        if (numbers[i] >= COMBOLOCK_DIAL_POSITIONS || numbers[i] != numbers[i + COMBINATION_LENGTH]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static char const *expected_status(expectation_t const *expected, char *buffer) {
+    static char const *const text[] = {
+            [LOCKED] = " ", [UNLOCKED] = "OPEN", [CHANGING] = "enter", [ALARMED] = "alert!"
+    };
+    if (expected->state == LOCKED && expected->bad_tries > 0) {
+        sprintf(buffer, "bad try %d", expected->bad_tries);
+        return buffer;
+    }
+    return text[expected->state];
+}
+
+/* The scripts */
+
+static stimulus_t *add_step(simulated_lock_t *sim, uint8_t levels) {
+    stimulus_t *step = &sim->script[sim->script_length++];
+    memset(step, 0, sizeof(*step));
+    step->levels = levels;
+    return step;
+}
+
+/* Spreads a turn over steps, as the encoder's ISR would between two loop()
+ * iterations; a long turn goes faster so as to fit in MAXIMUM_STEPS_PER_TURN. */
+static void add_turn(simulated_lock_t *sim, int detents) {
+    for (int steps_left = MAXIMUM_STEPS_PER_TURN; detents != 0; steps_left--) {
+        int chunk = 1 + (int) random_below(sim, MAXIMUM_DETENTS_PER_STEP);
+        int fastest = (abs(detents) + steps_left - 1) / steps_left;
+        if (chunk < fastest) {
+            chunk = fastest;
+        }
+        if (chunk > abs(detents)) {
+            chunk = abs(detents);
+        }
+        stimulus_t *step = add_step(sim, 0);
+        step->detents = (int8_t) ((detents > 0) ? chunk : -chunk);
+        if (random_below(sim, 8) == 0) {
+            // a stray key, which must not turn up later as a digit
+            step->number_of_keys = 1;
+            step->keys[0] = (char) ('0' + random_below(sim, 10));
+        }
+        detents -= step->detents;
+    }
+}
+
+static void add_noise(simulated_lock_t *sim, stimulus_t *step) {
+    if (random_below(sim, 4) == 0) {
+        step->detents = (int8_t) (random_below(sim, 2 * MAXIMUM_DETENTS_PER_STEP + 1) - MAXIMUM_DETENTS_PER_STEP);
+    }
+}
+
+static void plan_attempt(simulated_lock_t *sim) {
+    expectation_t *expected = &sim->expected;
+    unsigned turns[COMBINATION_LENGTH];
+    if (random_below(sim, 2) == 0) {
+        uint8_t position = 0;
+        for (int i = 0; i < COMBINATION_LENGTH; i++) {
+            turns[i] = (i > 0) + detents_to(position, expected->combination[i], i % 2 == 0)
+                       + (required_passes[i] - 1) * COMBOLOCK_DIAL_POSITIONS;
+            position = expected->combination[i];
+        }
+    } else {
+        for (int i = 0; i < COMBINATION_LENGTH; i++) {
+            turns[i] = 1 + random_below(sim, 3 * COMBOLOCK_DIAL_POSITIONS);
+        }
+    }
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        add_turn(sim, (i % 2 == 0) ? (int) turns[i] : -(int) turns[i]);
+    }
+    add_step(sim, 1 << LEFT_BUTTON);
+    if (expected->state == ALARMED) {
+        // nothing opens an alarmed lock
+    } else if (dialing_opens(turns, expected->combination)) {
+        expected->state = UNLOCKED;
+    } else if (++expected->bad_tries >= MAXIMUM_BAD_TRIES) {
+        expected->state = ALARMED;
+    }
+}
+
+static void plan_relock(simulated_lock_t *sim) {
+    add_noise(sim, add_step(sim, 1 << RIGHT_BUTTON));
+    add_noise(sim, add_step(sim, (1 << RIGHT_BUTTON) | (1 << LEFT_BUTTON)));
+    add_step(sim, 0);
+    sim->expected.state = LOCKED;
+    sim->expected.bad_tries = 0;
+}
+
+static void plan_combination_change(simulated_lock_t *sim) {
+    expectation_t *expected = &sim->expected;
+    uint8_t const changing = 1 << LEFT_SWITCH;
+    uint8_t numbers[NEW_COMBINATION_LENGTH];
+    bool typo = (random_below(sim, 4) == 0);
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        numbers[i] = (uint8_t) random_below(sim, typo ? 100 : COMBOLOCK_DIAL_POSITIONS);
+        numbers[i + COMBINATION_LENGTH] = typo ? (uint8_t) random_below(sim, 100) : numbers[i];
+    }
+    add_noise(sim, add_step(sim, changing));
+    add_noise(sim, add_step(sim, changing | (1 << RIGHT_BUTTON)));
+    for (int i = 0; i < NEW_COMBINATION_LENGTH; i++) {
+        stimulus_t *step = add_step(sim, changing);
+        step->number_of_keys = 2;
+        step->keys[0] = (char) ('0' + numbers[i] / 10);
+        step->keys[1] = (char) ('0' + numbers[i] % 10);
+        add_noise(sim, step);
+    }
+    add_noise(sim, add_step(sim, 0));
+    if (new_combination_is_valid(numbers)) {
+        memcpy(expected->combination, numbers, COMBINATION_LENGTH);
+    }
+}
+
+static void plan_reset(simulated_lock_t *sim, bool by_technician) {
+    expectation_t *expected = &sim->expected;
+    stimulus_t *step = add_step(sim, 0);
+    step->reset = by_technician ? TECHNICIAN_RESET : POWER_CYCLE;
+    if (by_technician) {
+        get_default_combination(expected->combination);
+        expected->bad_tries = 0;
+    }
+    expected->state = (expected->bad_tries >= MAXIMUM_BAD_TRIES) ? ALARMED : LOCKED;
+}
+
+static void plan_script(simulated_lock_t *sim) {
+    sim->script_length = 0;
+    sim->script_step = 0;
+    uint32_t choice = random_below(sim, 100);
+    if (choice < 2) {
+        plan_reset(sim, false);
+    } else if (sim->expected.state == LOCKED) {
+        plan_attempt(sim);
+    } else if (sim->expected.state == UNLOCKED) {
+        if (choice < 50) {
+            plan_relock(sim);
+        } else {
+            plan_combination_change(sim);
+        }
+    } else if (choice < 50) {
+        plan_attempt(sim);
+    } else {
+        plan_reset(sim, true);
+    }
+}
+
+static void report_divergence(fleet_thread_t *thread, simulated_lock_t const *sim, char const *what,
+                              int expected, int actual) {
+    thread->divergences++;
+    pthread_mutex_lock(&report_mutex);
+    if (++reported_divergences <= MAXIMUM_REPORTED_DIVERGENCES) {
+        printf("lock %ld, script %u: expected %s %d, found %d\n",
+               (long) (sim - thread->locks) + (long) thread->index * thread->number_of_locks,
+               sim->scripts, what, expected, actual);
+    }
+    pthread_mutex_unlock(&report_mutex);
+}
+
+static void check_lock(fleet_thread_t *thread, simulated_lock_t *sim) {
+    expectation_t *expected = &sim->expected;
+    lock_instance_t const *lock = &sim->lock;
+    bool diverged = false;
+    if (lock->state != expected->state) {
+        report_divergence(thread, sim, "state", expected->state, lock->state);
+        diverged = true;
+    }
+    if (lock->bad_tries != expected->bad_tries || sim->stored_bad_tries != expected->bad_tries) {
+        report_divergence(thread, sim, "bad tries", expected->bad_tries,
+                          (lock->bad_tries != expected->bad_tries) ? lock->bad_tries : sim->stored_bad_tries);
+        diverged = true;
+    }
+    if (memcmp(lock->combination, expected->combination, COMBINATION_LENGTH)
+        || memcmp(sim->stored_combination, expected->combination, COMBINATION_LENGTH)) {
+        report_divergence(thread, sim, "first number", expected->combination[0], lock->combination[0]);
+        diverged = true;
+    }
+    char buffer[DISPLAY_COLUMNS];
+    if (fleet_io.display_string && strcmp(sim->display[0], expected_status(expected, buffer))) {
+        report_divergence(thread, sim, "status row for state", expected->state, lock->state);
+        diverged = true;
+    }
+    if (diverged) {
+        // carry on from where the lock is, so that one divergence is not counted over and over
+        expected->state = lock->state;
+        expected->bad_tries = lock->bad_tries;
+        memcpy(expected->combination, lock->combination, COMBINATION_LENGTH);
+    }
+}
+
+static void start_lock(simulated_lock_t *sim) {
+    sim->detents = 0;
+    sim->levels = 0;
+    memset(sim->display, 0, sizeof(sim->display));
+    initialize_lock_instance(&sim->lock, &fleet_io, sim, sim->stored_combination, sim->stored_bad_tries);
+}
+
+static void apply_stimulus(simulated_lock_t *sim, stimulus_t const *step) {
+    if (step->reset == TECHNICIAN_RESET) {
+        get_default_combination(sim->stored_combination);
+        sim->stored_bad_tries = 0;
+    }
+    if (step->reset != NO_RESET) {
+        sim->resets++;
+        start_lock(sim);
+    }
+    sim->detents += step->detents;
+    sim->number_of_input_events = 0;
+    sim->next_input_event = 0;
+    for (int input = 0; input < NUMBER_OF_INPUTS; input++) {
+        uint8_t mask = 1 << input;
+        if ((sim->levels ^ step->levels) & mask) {
+            input_event_t *event = &sim->input_events[sim->number_of_input_events++];
+            event->input = (uint8_t) input;
+            event->type = (step->levels & mask) ? INPUT_PRESSED : INPUT_RELEASED;
+            event->timestamp_ms = 0;
+        }
+    }
+    sim->levels = step->levels;
+    sim->number_of_key_events = 0;
+    sim->next_key_event = 0;
+    for (int i = 0; i < step->number_of_keys; i++) {
+        sim->key_events[sim->number_of_key_events++] = (keypad_event_t) {.key = step->keys[i], .pressed = true};
+        sim->key_events[sim->number_of_key_events++] = (keypad_event_t) {.key = step->keys[i], .pressed = false};
+    }
+}
+
+static void *run_fleet_thread(void *argument) {
+    fleet_thread_t *thread = argument;
+    for (unsigned step = 0; step < thread->steps; step++) {
+        for (unsigned i = 0; i < thread->number_of_locks; i++) {
+            simulated_lock_t *sim = &thread->locks[i];
+            if (sim->script_step == sim->script_length) {
+                if (sim->script_length > 0) {
+                    check_lock(thread, sim);
+                    sim->scripts++;
+                }
+                plan_script(sim);
+            }
+            apply_stimulus(sim, &sim->script[sim->script_step++]);
+            lock_state_t state = sim->lock.state;
+            uint64_t start = now_ns();
+            control_lock_instance(&sim->lock);
+            uint64_t latency = now_ns() - start;
+            thread->events_by_state[state]++;
+            thread->ns_by_state[state] += latency;
+            uint64_t bucket = latency / LATENCY_BUCKET_NS;
+            thread->latency_buckets[(bucket < NUMBER_OF_LATENCY_BUCKETS) ? bucket : NUMBER_OF_LATENCY_BUCKETS - 1]++;
+            if (latency > thread->longest_ns) {
+                thread->longest_ns = latency;
+            }
+        }
+    }
+    return NULL;
+}
+
+static uint64_t percentile_ns(uint64_t const buckets[], uint64_t events, double fraction) {
+    uint64_t threshold = (uint64_t) (fraction * (double) events);
+    uint64_t seen = 0;
+    for (int i = 0; i < NUMBER_OF_LATENCY_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen > threshold) {
+            return (uint64_t) (i + 1) * LATENCY_BUCKET_NS;
+        }
+    }
+    return NUMBER_OF_LATENCY_BUCKETS * LATENCY_BUCKET_NS;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned number_of_locks = DEFAULT_LOCKS;
+    unsigned steps = DEFAULT_STEPS;
+    long number_of_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t seed = 1;
+    int option;
+    while ((option = getopt(argc, argv, "l:s:j:r:n")) != -1) {
+        switch (option) {
+            case 'l':
+                number_of_locks = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                steps = (unsigned) strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                number_of_threads = strtol(optarg, NULL, 10);
+                break;
+            case 'r':
+                seed = (uint32_t) strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                fleet_io.display_string = NULL;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-l locks] [-s steps] [-j threads] [-r seed] [-n]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (number_of_threads < 1) {
+        number_of_threads = 1;
+    }
+    if ((unsigned) number_of_threads > number_of_locks) {
+        number_of_threads = (long) number_of_locks;
+    }
+    number_of_locks -= number_of_locks % (unsigned) number_of_threads;
+    if (number_of_locks == 0) {
+        fprintf(stderr, "no locks to run\n");
+        return 2;
+    }
+    simulated_lock_t *locks = calloc(number_of_locks, sizeof(simulated_lock_t));
+    fleet_thread_t *threads = calloc((size_t) number_of_threads, sizeof(fleet_thread_t));
+    pthread_t *handles = calloc((size_t) number_of_threads, sizeof(pthread_t));
+    if (locks == NULL || threads == NULL || handles == NULL) {
+        fprintf(stderr, "cannot allocate %u locks\n", number_of_locks);
+        return 2;
+    }
+    for (unsigned i = 0; i < number_of_locks; i++) {
+        simulated_lock_t *sim = &locks[i];
+        sim->random = (seed + i) * 2654435761u | 1;
+        get_default_combination(sim->stored_combination);
+        start_lock(sim);
+        sim->expected.state = LOCKED;
+        get_default_combination(sim->expected.combination);
+    }
+    unsigned locks_per_thread = number_of_locks / (unsigned) number_of_threads;
+    uint64_t start = now_ns();
+    for (long t = 0; t < number_of_threads; t++) {
+        threads[t] = (fleet_thread_t) {
+                .locks = locks + t * locks_per_thread, .number_of_locks = locks_per_thread, .steps = steps,
+                .index = (unsigned) t
+        };
+        pthread_create(&handles[t], NULL, run_fleet_thread, &threads[t]);
+    }
+    for (long t = 0; t < number_of_threads; t++) {
+        pthread_join(handles[t], NULL);
+    }
+    double seconds = (double) (now_ns() - start) / 1e9;
+
+    static uint64_t buckets[NUMBER_OF_LATENCY_BUCKETS];
+    uint64_t events_by_state[NUMBER_OF_LOCK_STATES] = {0};
+    uint64_t ns_by_state[NUMBER_OF_LOCK_STATES] = {0};
+    uint64_t events = 0;
+    uint64_t total_ns = 0;
+    uint64_t longest_ns = 0;
+    uint64_t divergences = 0;
+    for (long t = 0; t < number_of_threads; t++) {
+        for (int i = 0; i < NUMBER_OF_LATENCY_BUCKETS; i++) {
+            buckets[i] += threads[t].latency_buckets[i];
+        }
+        for (int state = 0; state < NUMBER_OF_LOCK_STATES; state++) {
+            events_by_state[state] += threads[t].events_by_state[state];
+            ns_by_state[state] += threads[t].ns_by_state[state];
+            events += threads[t].events_by_state[state];
+            total_ns += threads[t].ns_by_state[state];
+        }
+        if (threads[t].longest_ns > longest_ns) {
+            longest_ns = threads[t].longest_ns;
+        }
+        divergences += threads[t].divergences;
+    }
+    uint64_t unlocks = 0, alarms = 0, bad_tries = 0, changes = 0, resets = 0, scripts = 0;
+    for (unsigned i = 0; i < number_of_locks; i++) {
+        unlocks += locks[i].unlocks;
+        alarms += locks[i].alarms;
+        bad_tries += locks[i].bad_tries;
+        changes += locks[i].combination_changes;
+        resets += locks[i].resets;
+        scripts += locks[i].scripts;
+    }
+
+    printf("%u locks on %ld threads, %llu events in %.3f s: %.2f million events/s\n",
+           number_of_locks, number_of_threads, (unsigned long long) events, seconds, (double) events / seconds / 1e6);
+    printf("latency per event: mean %.1f ns, p50 %llu ns, p99 %llu ns, p99.9 %llu ns, longest %llu ns\n",
+           (double) total_ns / (double) events,
+           (unsigned long long) percentile_ns(buckets, events, 0.5),
+           (unsigned long long) percentile_ns(buckets, events, 0.99),
+           (unsigned long long) percentile_ns(buckets, events, 0.999),
+           (unsigned long long) longest_ns);
+    printf("%-10s %12s %9s\n", "state", "events", "mean ns");
+    for (int state = 0; state < NUMBER_OF_LOCK_STATES; state++) {
+        printf("%-10s %12llu %9.1f\n", get_lock_state_name((lock_state_t) state),
+               (unsigned long long) events_by_state[state],
+               events_by_state[state] ? (double) ns_by_state[state] / (double) events_by_state[state] : 0.0);
+    }
+    printf("%llu scripts: %llu unlocks, %llu bad tries, %llu alarms, %llu combination changes, %llu resets\n",
+           (unsigned long long) scripts, (unsigned long long) unlocks, (unsigned long long) bad_tries,
+           (unsigned long long) alarms, (unsigned long long) changes, (unsigned long long) resets);
+    printf("%llu divergences from the model\n", (unsigned long long) divergences);
+    free(handles);
+    free(threads);
+    free(locks);
+    return (divergences == 0) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/**************************************************************************//**
+ *
+ * @file host-hal.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Controls for the host stand-in for the CowPi hardware: the switches,
+ *      buttons, keypad and dial that a person would handle, and the LEDs and
+ *      display that they would see.
+ *
+ * The SIO block and the timer are mapped at their RP2040 addresses, so the
+ * firmware's register accesses work unchanged. There is no preemption: timer
+ * interrupts are serviced by service_host_timers(), which the driver calls
+ * between loop() iterations, and pin interrupts are serviced as soon as the
+ * driver changes a pin.
+ *
+ * The clock is either real or virtual. Virtual time only moves when the
+ * driver advances it or the firmware waits, and then it jumps, running every
+ * timer ISR that falls due on the way, so a one-second LED pattern takes no
+ * wall time at all.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_HOST_HAL_H
+#define COMBOLOCK_HOST_HAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rotary-encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    HOST_LEFT, HOST_RIGHT
+} host_side_t;
+
+/**
+ * Maps the SIO block and the timer, and starts the clock. Exits the process
+ * if the register addresses are unavailable.
+ */
+void initialize_host_hal(void);
+
+/**
+ * @return Microseconds since initialize_host_hal(), real or virtual
+ */
+uint64_t get_host_time_us(void);
+
+/**
+ * Stops the clock, from now on moving it only by advance_host_time() and
+ * the waits below.
+ */
+void use_host_virtual_time(void);
+
+bool host_time_is_virtual(void);
+
+/**
+ * Moves virtual time forward by `microseconds`, servicing the timers at each
+ * deadline on the way. Busy-waits instead if the clock is real.
+ */
+void advance_host_time(uint64_t microseconds);
+
+/**
+ * Moves virtual time to the next periodic timer deadline and services the
+ * timers; services the timers without moving the clock if it is real.
+ */
+void advance_host_time_to_next_timer(void);
+
+/**
+ * @return Nanoseconds since initialize_host_hal(), wrapping at 32 bits
+ */
+uint32_t get_host_clock_ns(void);
+
+/**
+ * Brings the timer registers up to date and runs every periodic ISR whose
+ * deadline has passed, once per period missed.
+ */
+void service_host_timers(void);
+
+/**
+ * Stands in for WFI: sleeps until the next periodic timer deadline, or jumps
+ * to it in virtual time, then services the timers.
+ */
+void wait_for_host_interrupt(void);
+
+/**
+ * @return The number of periodic and pin ISR invocations so far
+ */
+uint64_t get_host_interrupt_count(void);
+
+void set_host_button(host_side_t button, bool pressed);
+void set_host_switch(host_side_t slide_switch, bool in_right_position);
+
+/**
+ * Holds a key on the keypad, or releases all keys if `key` is NUL.
+ */
+void set_host_key(char key);
+
+/**
+ * Turns the dial one detent, walking the wipers through the four quadrature
+ * states and servicing the pin interrupt after each change.
+ */
+void turn_host_dial(direction_t direction);
+
+/**
+ * Inverts an input pin, as the RP2040's input override does, and services the
+ * pin interrupt (or holds it pending while interrupts are masked).
+ */
+void toggle_host_pin(unsigned int pin);
+
+bool host_led_is_lit(host_side_t led);
+
+/**
+ * @return The text on the given row of the display as of its last refresh
+ */
+char const *get_host_display_row(int row);
+
+/**
+ * @return The number of times the display has been refreshed
+ */
+uint32_t get_host_display_refreshes(void);
+
+/**
+ * When enabled, the display's text is printed to stderr whenever a refresh
+ * changes it.
+ */
+void set_host_display_echo(bool enabled);
+
+/**
+ * Makes each display refresh busy-wait as long as its I2C transfer would take
+ * on the RP2040: about 23000 us for a full frame at 400 kHz. The default, 0,
+ * leaves refreshes free.
+ */
+void set_host_display_flush_time(uint32_t microseconds);
+
+/**
+ * @return <code>true</code> if the watchdog has gone unkicked for longer than
+ *      its timeout, so the RP2040 would have reset
+ */
+bool host_watchdog_has_expired(void);
+
+/**
+ * @return The number of times the watchdog has been kicked
+ */
+uint32_t get_host_watchdog_kicks(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_HOST_HAL_H
@@ -0,0 +1,63 @@
+/**************************************************************************//**
+ *
+ * @file Adafruit_SSD1306.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A headless stand-in for the Adafruit_SSD1306 display driver.
+ *
+ * Bitmaps are drawn into a 128x64 framebuffer laid out as the SSD1306 lays out
+ * its memory. Text is not rasterized; it is kept as rows of characters, so
+ * that a driver can read back what the screen says. display() copies both to
+ * the "panel", which host-hal.h exposes.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_HOST_ADAFRUIT_SSD1306_H
+#define COMBOLOCK_HOST_ADAFRUIT_SSD1306_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SSD1306_BLACK               (0)
+#define SSD1306_WHITE               (1)
+#define SSD1306_INVERSE             (2)
+#define SSD1306_EXTERNALVCC         (0x01)
+#define SSD1306_SWITCHCAPVCC        (0x02)
+
+#define HOST_DISPLAY_WIDTH          (128)
+#define HOST_DISPLAY_HEIGHT         (64)
+#define HOST_DISPLAY_TEXT_ROWS      (8)
+#define HOST_DISPLAY_TEXT_COLUMNS   (21)
+
+class Adafruit_SSD1306 {
+public:
+    Adafruit_SSD1306(uint8_t width, uint8_t height);
+
+    bool begin(uint8_t switchvcc = SSD1306_SWITCHCAPVCC, uint8_t i2caddr = 0, bool reset = true,
+               bool periphBegin = true);
+    void clearDisplay(void);
+    void display(void);
+    void drawPixel(int16_t x, int16_t y, uint16_t color);
+    void drawBitmap(int16_t x, int16_t y, uint8_t const bitmap[], int16_t w, int16_t h, uint16_t color);
+    void setTextSize(uint8_t size);
+    void setTextColor(uint16_t color);
+    void setCursor(int16_t x, int16_t y);
+    size_t print(char const *string);
+    uint8_t *getBuffer(void);
+
+private:
+    uint8_t buffer[HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT / 8];
+    char text[HOST_DISPLAY_TEXT_ROWS][HOST_DISPLAY_TEXT_COLUMNS + 1];
+    uint8_t text_size;
+    int16_t cursor_x;
+    int16_t cursor_y;
+};
+
+#endif //COMBOLOCK_HOST_ADAFRUIT_SSD1306_H
@@ -0,0 +1,123 @@
+/**************************************************************************//**
+ *
+ * @file CowPi.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A stand-in for the parts of the CowPi library (and of the Arduino
+ *      core beneath it) that the firmware uses, so that it can be built and
+ *      run as a Linux process.
+ *
+ * Only the native environment puts this directory on the include path. The
+ * functions are implemented in host/cowpi-hal.c, and are driven through
+ * host-hal.h.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_HOST_COWPI_H
+#define COMBOLOCK_HOST_COWPI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COWPI_VERSION           ("0.8-host")
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The RP2040's single-cycle IO block, as mapped at 0xD0000000. */
+typedef struct {
+    uint32_t cpuid;
+    uint32_t input;
+    uint32_t input_high;
+    uint32_t reserved;
+    uint32_t output;
+    uint32_t output_set;
+    uint32_t output_clear;
+    uint32_t output_toggle;
+    uint32_t output_enable;
+    uint32_t output_enable_set;
+    uint32_t output_enable_clear;
+    uint32_t output_enable_toggle;
+} cowpi_ioport_t;
+
+/** The RP2040's 1MHz timer, as mapped at 0x40054000. */
+typedef struct {
+    uint32_t write_upper_word;
+    uint32_t write_lower_word;
+    uint32_t read_upper_word;
+    uint32_t read_lower_word;
+    uint32_t alarm[4];
+    uint32_t armed;
+    uint32_t raw_upper_word;
+    uint32_t raw_lower_word;
+    uint32_t debug_pause;
+    uint32_t pause;
+    uint32_t raw_interrupts;
+    uint32_t interrupt_enable;
+    uint32_t interrupt_force;
+    uint32_t interrupt_status;
+} cowpi_timer_t;
+
+typedef struct {
+    enum {
+        NO_MODULE, SEVEN_SEGMENT, LED_MATRIX, LCD_CHARACTER, SSD1306
+    } display_module;
+} cowpi_display_module_t;
+
+typedef struct {
+    enum {
+        NO_PROTOCOL, SPI, I2C
+    } protocol;
+} cowpi_display_module_protocol_t;
+
+void cowpi_setup(unsigned int configuration, cowpi_display_module_t display_module,
+                 cowpi_display_module_protocol_t display_protocol);
+
+void cowpi_set_output_pins(uint32_t pin_mask);
+void cowpi_set_pullup_input_pins(uint32_t pin_mask);
+
+bool cowpi_left_button_is_pressed(void);
+bool cowpi_right_button_is_pressed(void);
+bool cowpi_left_switch_is_in_left_position(void);
+bool cowpi_left_switch_is_in_right_position(void);
+bool cowpi_right_switch_is_in_left_position(void);
+bool cowpi_right_switch_is_in_right_position(void);
+char cowpi_get_keypress(void);
+
+void cowpi_illuminate_left_led(void);
+void cowpi_deluminate_left_led(void);
+void cowpi_illuminate_right_led(void);
+void cowpi_deluminate_right_led(void);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void noInterrupts(void);
+void interrupts(void);
+
+#ifdef __cplusplus
+} // extern "C"
+
+template<typename T>
+static inline T min(T a, T b) {
+    return (b < a) ? b : a;
+}
+
+template<typename T>
+static inline T max(T a, T b) {
+    return (a < b) ? b : a;
+}
+#endif //__cplusplus
+
+#endif //COMBOLOCK_HOST_COWPI_H
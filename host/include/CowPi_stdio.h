@@ -0,0 +1,25 @@
+/**************************************************************************//**
+ *
+ * @file CowPi_stdio.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A stand-in for the CowPi_stdio library; on the host, stdio is
+ *      already connected to the terminal.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_HOST_COWPI_STDIO_H
+#define COMBOLOCK_HOST_COWPI_STDIO_H
+
+#include <stdio.h>
+
+#define COWPI_STDIO_VERSION     ("0.6-host")
+
+#endif //COMBOLOCK_HOST_COWPI_STDIO_H
@@ -0,0 +1,170 @@
+/**************************************************************************//**
+ *
+ * @file isr-bench.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Times the interrupt-driven hot paths against the register
+ *      stand-ins: pin-interrupt dispatch, a quadrature edge, a whole detent,
+ *      and the servo's timer ISR. Reports ns/op and, where the kernel allows
+ *      hardware counters, instructions/op.
+ *
+ * Usage: <code>isr-bench [-b baseline] [-t percent] [-u]</code>. The first
+ * run on a machine writes its results to the baseline file
+ * (<code>isr-bench.baseline</code> by default); later runs compare against
+ * it and exit with status 1 if any path is more than `percent` (20 by
+ * default) slower, or executes that many more instructions. <code>-u</code>
+ * rewrites the baseline after an intended change. Timings are only
+ * comparable on the machine that wrote the baseline; instruction counts are
+ * comparable wherever the compiler is the same.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unistd.h>
+#include "bench-timer.h"
+#include "detent-delta.h"
+#include "host-hal.h"
+#include "interrupt_support.h"
+#include "rotary-encoder.h"
+#include "servo-interrupt.h"
+#include "servomotor.h"
+
+#define A_WIPER_PIN         (16)
+#define SPARE_PIN           (28)
+#define OPERATIONS          (200000)        // even, so that toggled pins end where they started
+#define RUNS                (7)             // the fastest run is reported
+#define DEFAULT_BASELINE    "isr-bench.baseline"
+#define DEFAULT_THRESHOLD   (20.0)
+
+typedef struct {
+    char const *name;
+    void (*operation)(void);
+    double ns_per_op;
+    double instructions_per_op;     // negative if unavailable
+} kernel_t;
+
+static void do_nothing(void) {}
+
+static void dispatch_pin_interrupt(void) {
+    toggle_host_pin(SPARE_PIN);
+}
+
+static void quadrature_edge(void) {
+    toggle_host_pin(A_WIPER_PIN);
+}
+
+static void detent(void) {
+    turn_host_dial(CLOCKWISE);
+    take_detent_delta();
+}
+
+static kernel_t kernels[] = {
+        {.name = "pin_dispatch", .operation = dispatch_pin_interrupt},
+        {.name = "quadrature_edge", .operation = quadrature_edge},
+        {.name = "detent", .operation = detent},
+        {.name = "servo_isr", .operation = run_servo_interrupt},
+};
+#define NUMBER_OF_KERNELS   ((int) (sizeof(kernels) / sizeof(kernels[0])))
+
+static void run_kernel(kernel_t *kernel) {
+    bench_timing_t timing = time_operation(kernel->operation, OPERATIONS, RUNS);
+    kernel->ns_per_op = timing.ns_per_op;
+    kernel->instructions_per_op = timing.instructions_per_op;
+}
+
+static bool write_baseline(char const *filename) {
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        perror(filename);
+        return false;
+    }
+    for (int i = 0; i < NUMBER_OF_KERNELS; i++) {
+        fprintf(file, "%s %.3f %.1f\n", kernels[i].name, kernels[i].ns_per_op, kernels[i].instructions_per_op);
+    }
+    fclose(file);
+    printf("baseline written to %s\n", filename);
+    return true;
+}
+
+static bool exceeds(double value, double baseline, double threshold_percent) {
+    return baseline > 0 && value > baseline * (1 + threshold_percent / 100);
+}
+
+static int compare_with_baseline(FILE *file, double threshold_percent) {
+    int regressions = 0;
+    char name[32];
+    double ns_per_op;
+    double instructions_per_op;
+    while (fscanf(file, "%31s %lf %lf", name, &ns_per_op, &instructions_per_op) == 3) {
+        for (int i = 0; i < NUMBER_OF_KERNELS; i++) {
+            if (strcmp(name, kernels[i].name) != 0) {
+                continue;
+            }
+            kernel_t const *kernel = &kernels[i];
+            if (exceeds(kernel->ns_per_op, ns_per_op, threshold_percent)) {
+                printf("REGRESSION %s: %.1f ns/op against a baseline of %.1f\n", name, kernel->ns_per_op, ns_per_op);
+                regressions++;
+            }
+            if (kernel->instructions_per_op >= 0
+                && exceeds(kernel->instructions_per_op, instructions_per_op, threshold_percent)) {
+                printf("REGRESSION %s: %.1f instructions/op against a baseline of %.1f\n", name,
+                       kernel->instructions_per_op, instructions_per_op);
+                regressions++;
+            }
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char *argv[]) {
+    char const *baseline = DEFAULT_BASELINE;
+    double threshold_percent = DEFAULT_THRESHOLD;
+    bool update = false;
+    int option;
+    while ((option = getopt(argc, argv, "b:t:u")) != -1) {
+        switch (option) {
+            case 'b':
+                baseline = optarg;
+                break;
+            case 't':
+                threshold_percent = strtod(optarg, NULL);
+                break;
+            case 'u':
+                update = true;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-b baseline] [-t percent] [-u]\n", argv[0]);
+                return 2;
+        }
+    }
+    initialize_host_hal();
+    initialize_rotary_encoder();
+    initialize_servo();
+    register_pin_ISR(1 << SPARE_PIN, do_nothing);
+    printf("%-16s %10s %14s\n", "path", "ns/op", "instructions/op");
+    for (int i = 0; i < NUMBER_OF_KERNELS; i++) {
+        run_kernel(&kernels[i]);
+        printf("%-16s %10.1f ", kernels[i].name, kernels[i].ns_per_op);
+        if (kernels[i].instructions_per_op < 0) {
+            printf("%14s\n", "n/a");
+        } else {
+            printf("%14.1f\n", kernels[i].instructions_per_op);
+        }
+    }
+    FILE *file = update ? NULL : fopen(baseline, "r");
+    if (file == NULL) {
+        return write_baseline(baseline) ? 0 : 2;
+    }
+    int regressions = compare_with_baseline(file, threshold_percent);
+    fclose(file);
+    printf("%d regression%s beyond %.0f%% of %s\n", regressions, (regressions == 1) ? "" : "s", threshold_percent,
+           baseline);
+    return (regressions > 0) ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+#!/bin/sh
+#
+# @file isr-size.sh
+#
+# @author Nick Goertzen
+# @author Nolan Hill
+#
+# @brief Counts the instructions in each interrupt handler by disassembling
+#      the object files, so that a change that makes an ISR bigger (say, a
+#      register access that stops compiling to a single load or store) shows
+#      up without needing the hardware.
+#
+# Usage: isr-size.sh [-p prefix] [-b baseline] [-t percent] [-u] object...
+#
+# `prefix` selects the toolchain, e.g. `arm-none-eabi-` for the objects under
+# .pio/build/pico/src; without it the host's objdump is used. As with
+# isr-bench, the first run writes the counts to the baseline file
+# (isr-size.baseline by default), later runs exit with status 1 if any
+# handler has grown by more than `percent` (0 by default), and -u rewrites
+# the baseline after an intended change. Counts are only comparable between
+# runs with the same compiler and target.
+#
+# ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+# ComboLock solution (c) the above-named students
+#
+
+prefix=""
+baseline="isr-size.baseline"
+threshold=0
+update=0
+while getopts "p:b:t:u" option; do
+    case $option in
+        p) prefix=$OPTARG ;;
+        b) baseline=$OPTARG ;;
+        t) threshold=$OPTARG ;;
+        u) update=1 ;;
+        *) echo "usage: $0 [-p prefix] [-b baseline] [-t percent] [-u] object..." >&2; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+if [ $# -eq 0 ]; then
+    echo "usage: $0 [-p prefix] [-b baseline] [-t percent] [-u] object..." >&2
+    exit 2
+fi
+
+# one "name instructions" line per handler; alignment padding is not counted
+counts=$("${prefix}objdump" -d -C "$@" | awk '
+    /^[0-9a-f]+ <.*>:$/ {
+        name = $0
+        sub(/^[0-9a-f]+ </, "", name)
+        sub(/\(.*$/, "", name)
+        sub(/>:$/, "", name)
+        in_handler = (name ~ /^handle_.*interrupt$/)
+        if (in_handler) {
+            count[name] = 0
+        }
+        next
+    }
+    in_handler && /^ +[0-9a-f]+:\t/ {
+        split($0, fields, "\t")
+        if (fields[3] != "" && fields[3] !~ /^(nop|xchg +%ax,%ax)/) {
+            count[name]++
+        }
+    }
+    END {
+        for (name in count) {
+            printf "%s %d\n", name, count[name]
+        }
+    }' | sort)
+
+if [ -z "$counts" ]; then
+    echo "no interrupt handlers found" >&2
+    exit 2
+fi
+
+printf "%-32s %12s %9s\n" "handler" "instructions" "baseline"
+if [ $update -eq 1 ] || [ ! -f "$baseline" ]; then
+    echo "$counts" | while read -r name instructions; do
+        printf "%-32s %12d %9s\n" "$name" "$instructions" "-"
+    done
+    echo "$counts" > "$baseline"
+    echo "baseline written to $baseline"
+    exit 0
+fi
+
+echo "$counts" | awk -v threshold="$threshold" '
+    FNR == NR {
+        reference[$1] = $2
+        next
+    }
+    {
+        if ($1 in reference) {
+            printf "%-32s %12d %9d", $1, $2, reference[$1]
+            if ($2 > reference[$1] * (1 + threshold / 100)) {
+                printf "  GREW"
+                grew = 1
+            }
+            printf "\n"
+        } else {
+            printf "%-32s %12d %9s\n", $1, $2, "-"
+        }
+    }
+    END {
+        exit grew
+    }' "$baseline" -
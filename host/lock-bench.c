@@ -0,0 +1,121 @@
+/**************************************************************************//**
+ *
+ * @file lock-bench.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Times one pass of the lock's control loop while it sits idle in
+ *      LOCKED, with the view model as it is and with every row re-formatted
+ *      and re-sent on each pass, which is what the lock did before it had a
+ *      view model. Reports ns/pass and, where the kernel allows hardware
+ *      counters, instructions/pass.
+ *
+ * Usage: <code>lock-bench</code>. The lock is wired as host/fleet.c wires its
+ * locks, to stub callbacks: nothing is turned or pressed, so each pass finds
+ * no input, and the LEDs and bolt go nowhere. Only the rows go to the real
+ * display module, as it is their formatting and sending that is measured.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "bench-timer.h"
+#include "display.h"
+#include "host-hal.h"
+#include "lock-instance.h"
+
+#define PASSES  (200000)
+#define RUNS    (7)                 // the fastest run is reported
+
+static lock_instance_t lock;
+
+static int take_no_detents(void *context) {
+    return 0;
+}
+
+static bool take_no_input_event(void *context, input_event_t *event) {
+    return false;
+}
+
+static bool take_no_keypad_event(void *context, keypad_event_t *event) {
+    return false;
+}
+
+static bool nothing_is_pressed(void *context, input_t input) {
+    return false;
+}
+
+static bool no_pattern_is_active(void *context) {
+    return false;
+}
+
+static void show_string(void *context, int row, char const *text) {
+    display_string(row, text);
+}
+
+static lock_io_t const bench_lock_io = {
+        .take_detent_delta = take_no_detents,
+        .get_input_event = take_no_input_event,
+        .get_keypad_event = take_no_keypad_event,
+        .input_is_pressed = nothing_is_pressed,
+        .pattern_is_active = no_pattern_is_active,
+        .display_string = show_string,
+};
+
+static void idle_pass(void) {
+    control_lock_instance(&lock);
+}
+
+static void idle_pass_redrawing_everything(void) {
+    lock.view_is_rendered = false;
+    control_lock_instance(&lock);
+}
+
+typedef struct {
+    char const *name;
+    void (*pass)(void);
+    double ns_per_pass;
+    double instructions_per_pass;   // negative if unavailable
+} variant_t;
+
+static variant_t variants[] = {
+        {.name = "full_redraw", .pass = idle_pass_redrawing_everything},
+        {.name = "view_model", .pass = idle_pass},
+};
+#define NUMBER_OF_VARIANTS  ((int) (sizeof(variants) / sizeof(variants[0])))
+
+static void run_variant(variant_t *variant) {
+    bench_timing_t timing = time_operation(variant->pass, PASSES, RUNS);
+    variant->ns_per_pass = timing.ns_per_op;
+    variant->instructions_per_pass = timing.instructions_per_op;
+}
+
+int main(int argc, char *argv[]) {
+    uint8_t combination[COMBINATION_LENGTH];
+    initialize_host_hal();
+    cowpi_setup(0,
+                (cowpi_display_module_t) {.display_module = NO_MODULE},
+                (cowpi_display_module_protocol_t) {.protocol = NO_PROTOCOL}
+               );
+    configure_display(21);
+    get_default_combination(combination);
+    initialize_lock_instance(&lock, &bench_lock_io, NULL, combination, 0);
+    printf("%-12s %10s %18s\n", "idle LOCKED", "ns/pass", "instructions/pass");
+    for (int i = 0; i < NUMBER_OF_VARIANTS; i++) {
+        run_variant(&variants[i]);
+        printf("%-12s %10.1f ", variants[i].name, variants[i].ns_per_pass);
+        if (variants[i].instructions_per_pass < 0) {
+            printf("%18s\n", "n/a");
+        } else {
+            printf("%18.1f\n", variants[i].instructions_per_pass);
+        }
+    }
+    printf("the view model takes %.1f%% of the time of a full redraw\n",
+           100 * variants[1].ns_per_pass / variants[0].ns_per_pass);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**************************************************************************//**
+ *
+ * @file main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Runs the firmware's setup() and loop() as a Linux process, with
+ *      loop() iterations back-to-back, for profiling.
+ *
+ * Usage: <code>combolock [-n iterations] [-t] [-e] [-f us] [-v] [-b]</code>
+ * <ul>
+ * <li> <code>-n</code> stops after the given number of loop() iterations;
+ *      otherwise the firmware runs until interrupted
+ * <li> <code>-t</code> starts in test mode (right switch to the left)
+ * <li> <code>-e</code> prints the display whenever its text changes
+ * <li> <code>-f</code> makes each display refresh take as long as the given
+ *      number of microseconds, as the I2C transfer does on the RP2040
+ * <li> <code>-v</code> runs on virtual time: between loop() iterations, and
+ *      whenever the firmware waits, the clock jumps to the next timer
+ *      deadline, so the firmware's timing runs as fast as the host can go
+ * <li> <code>-b</code> starts in test mode, holds # on the keypad to run the
+ *      self-bench, and stops once it has reported; it needs real time, so it
+ *      cannot be combined with <code>-v</code>
+ * </ul>
+ *
+ * Built with <code>-DCOMBOLOCK_TICKLESS</code>, loop() sleeps until a timer
+ * ISR posts work instead, and the idle duty cycle is printed at exit. Built
+ * with <code>-DCOMBOLOCK_DUAL_CORE</code>, a thread renders and flushes the
+ * display, and how many screens it showed is printed at exit.
+ *
+ * The process exits with status 3 if the watchdog would have reset the
+ * RP2040, after printing the flight recorder.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include "host-hal.h"
+#include "deadline-monitor.h"
+#include "display-core.h"
+#include "flight-recorder.h"
+#include "pending-work.h"
+#include "self-bench.h"
+#include "stack-monitor.h"
+
+void setup(void);
+void loop(void);
+
+/* pio test builds the firmware around each test's own main() */
+#ifndef PIO_UNIT_TESTING
+
+static sig_atomic_t volatile interrupted = 0;
+
+static void handle_sigint(int signal_number) {
+    interrupted = 1;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long long iterations = 0;
+    bool test_mode = false;
+    bool bench = false;
+    bool virtual_time = false;
+    int option;
+    while ((option = getopt(argc, argv, "n:tef:vb")) != -1) {
+        switch (option) {
+            case 'n':
+                iterations = strtoull(optarg, NULL, 10);
+                break;
+            case 't':
+                test_mode = true;
+                break;
+            case 'e':
+                set_host_display_echo(true);
+                break;
+            case 'f':
+                set_host_display_flush_time((uint32_t) strtoul(optarg, NULL, 10));
+                break;
+            case 'v':
+                virtual_time = true;
+                break;
+            case 'b':
+                test_mode = true;
+                bench = true;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-t] [-e] [-f us] [-v] [-b]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (bench && virtual_time) {
+        // the bench times its kernels against the clock, which virtual time holds still
+        fprintf(stderr, "%s: -b needs real time and cannot be used with -v\n", argv[0]);
+        return 2;
+    }
+    signal(SIGINT, handle_sigint);
+    initialize_host_hal();
+    if (virtual_time) {
+        use_host_virtual_time();
+    }
+    set_host_switch(HOST_RIGHT, !test_mode);
+    setup();
+    if (bench) {
+        set_host_key('#');
+    }
+    uint64_t start_us = get_host_time_us();
+    struct timespec wall_start;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+    uint64_t start_interrupts = get_host_interrupt_count();
+    unsigned long long count = 0;
+    while (!interrupted && (iterations == 0 || count < iterations)) {
+        advance_host_time_to_next_timer();
+        loop();
+        count++;
+        if (bench && get_self_bench_results() != NULL) {
+            break;
+        }
+        if (host_watchdog_has_expired()) {
+            printf("watchdog reset after %llu loop iterations\n", count);
+            dump_flight_recorder();
+            return 3;
+        }
+    }
+    double seconds = (get_host_time_us() - start_us) / 1e6;
+    printf("%llu loop iterations in %.3f s", count, seconds);
+    if (seconds > 0) {
+        printf(" (%.0f/s, %.3f us each)", count / seconds, 1e6 * seconds / (double) (count ? count : 1));
+    }
+    if (virtual_time) {
+        struct timespec wall_end;
+        clock_gettime(CLOCK_MONOTONIC, &wall_end);
+        printf(" of virtual time, in %.3f s of wall time",
+               (double) (wall_end.tv_sec - wall_start.tv_sec) + (wall_end.tv_nsec - wall_start.tv_nsec) / 1e9);
+    }
+    printf("\n%llu interrupts serviced, %u display refreshes\n",
+           (unsigned long long) (get_host_interrupt_count() - start_interrupts), get_host_display_refreshes());
+    deadline_metrics_t deadlines = get_deadline_metrics();
+    printf("%lu of %lu iterations over the %d us budget; worst %lu us (%s)\n", (unsigned long) deadlines.overruns,
+           (unsigned long) deadlines.iterations, COMBOLOCK_LOOP_BUDGET_US, (unsigned long) deadlines.worst_iteration_us,
+           get_subsystem_name((loop_subsystem_t) deadlines.worst_subsystem));
+    scan_stacks();
+    stack_usage_t stack = get_stack_usage(STACK_MAIN);
+    printf("main stack high-water mark %lu of %lu bytes\n", (unsigned long) stack.high_water_bytes,
+           (unsigned long) stack.size_bytes);
+#ifdef COMBOLOCK_DUAL_CORE
+    display_core_metrics_t display_core = get_display_core_metrics();
+    printf("%lu screens published, %lu shown by the display thread, %lu torn copies retried\n",
+           (unsigned long) display_core.published, (unsigned long) display_core.rendered,
+           (unsigned long) display_core.retries);
+#endif
+#ifdef COMBOLOCK_TICKLESS
+    idle_metrics_t idle = get_idle_metrics();
+    printf("idle %.1f%% of the time, %lu wakeups, %lu with work\n",
+           100.0 * (double) idle.idle_us / (double) (idle.elapsed_us ? idle.elapsed_us : 1),
+           (unsigned long) idle.wakeups, (unsigned long) idle.work_wakeups);
+#endif
+    return 0;
+}
+
+#endif //PIO_UNIT_TESTING
@@ -0,0 +1,149 @@
+/**************************************************************************//**
+ *
+ * @file replay.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Replays an input journal through the lock controller on the host and
+ *      reports where the replay's output diverges from the recording.
+ *
+ * Capture a journal by typing <code>journal</code> on the console, then turn
+ * the hexadecimal dump back into binary with <code>xxd -r -p</code>. Run with
+ * <code>replay journal.bin</code>; the exit status is nonzero if the journal
+ * could not be read or if any step's output differed from the recording.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "combination-engine.h"
+#include "detent-delta.h"
+#include "host-hal.h"
+#include "input-events.h"
+#include "input-journal.h"
+#include "keypad.h"
+#include "lock-controller.h"
+#include "rotary-encoder.h"
+#include "settings-store.h"
+
+#define MAXIMUM_REPORTED_DIVERGENCES    (10)
+
+static char const *state_names[] = {"LOCKED", "UNLOCKED", "CHANGING", "ALARMED"};
+
+static uint8_t journal[JOURNAL_CAPACITY];
+
+static size_t read_journal(char const *filename) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        perror(filename);
+        return 0;
+    }
+    size_t length = fread(journal, 1, sizeof(journal), file);
+    fclose(file);
+    return length;
+}
+
+static bool header_is_usable(size_t length) {
+    if (length < JOURNAL_HEADER_SIZE || memcmp(journal, JOURNAL_MAGIC, 3)) {
+        fprintf(stderr, "not an input journal\n");
+        return false;
+    }
+    if (journal[3] < 1 || journal[3] > JOURNAL_VERSION) {
+        fprintf(stderr, "journal version %d; expected 1 to %d\n", journal[3], JOURNAL_VERSION);
+        return false;
+    }
+    if (journal[4] != COMBOLOCK_DIAL_POSITIONS || journal[5] != COMBINATION_LENGTH) {
+        fprintf(stderr, "journal is for a %d-position dial with %d numbers; this build has %d and %d\n",
+                journal[4], journal[5], COMBOLOCK_DIAL_POSITIONS, COMBINATION_LENGTH);
+        return false;
+    }
+    return true;
+}
+
+/* Puts the controller where it was when recording started. The settings are
+ * written through the store so that initialize_lock_controller() loads them. */
+static void restore_starting_state(void) {
+    uint8_t bad_tries = journal[7];
+    initialize_host_hal();
+    initialize_settings_store(get_flash_device());
+    write_setting(SETTING_COMBINATION, journal + 8, COMBINATION_LENGTH);
+    write_setting(SETTING_BAD_TRIES, &bad_tries, sizeof(bad_tries));
+    while (service_settings_store()) {}
+    initialize_lock_controller();
+    stop_input_journal();
+    restore_input_levels(journal[6]);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s journal.bin\n", argv[0]);
+        return 2;
+    }
+    size_t length = read_journal(argv[1]);
+    if (!header_is_usable(length)) {
+        return 2;
+    }
+    restore_starting_state();
+    uint32_t timestamp_ms = 0;
+    unsigned long records = 0;
+    unsigned long steps = 0;
+    unsigned long divergences = 0;
+    clock_t start = clock();
+    for (size_t i = JOURNAL_HEADER_SIZE; i + JOURNAL_RECORD_SIZE <= length; i += JOURNAL_RECORD_SIZE) {
+        uint8_t type = journal[i];
+        uint8_t value = journal[i + 1];
+        timestamp_ms += journal[i + 2] | (journal[i + 3] << 8);
+        records++;
+        switch (type) {
+            case JOURNAL_DIRECTION:
+                inject_detent_delta((value == CLOCKWISE) ? 1 : (value == COUNTERCLOCKWISE) ? -1 : 0);
+                break;
+            case JOURNAL_DETENTS:
+                inject_detent_delta((int8_t) value);
+                break;
+            case JOURNAL_INPUT: {
+                input_event_t event = {(uint8_t) (value >> 4), (uint8_t) (value & 0xF), timestamp_ms};
+                inject_input_event(&event);
+                break;
+            }
+            case JOURNAL_KEY: {
+                keypad_event_t event = {(char) (value & 0x7F), (value & 0x80) != 0, timestamp_ms};
+                inject_keypad_event(&event);
+                break;
+            }
+            case JOURNAL_STEP:
+                control_lock();
+                steps++;
+                if (get_journal_output() != value) {
+                    if (++divergences <= MAXIMUM_REPORTED_DIVERGENCES) {
+                        uint8_t output = get_journal_output();
+                        printf("step %lu at %u ms: recorded %s with %d bad tries, replayed %s with %d bad tries\n",
+                               steps, timestamp_ms, state_names[value & 0x3], value >> 2,
+                               state_names[output & 0x3], output >> 2);
+                    }
+                }
+                break;
+            case JOURNAL_TIME:
+                break;
+            default:
+                fprintf(stderr, "unknown record type %d at offset %zu\n", type, i);
+                return 2;
+        }
+    }
+    double seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+    uint8_t output = get_journal_output();
+    printf("%lu records, %lu steps, %.1f s of recording\n", records, steps, timestamp_ms / 1000.0);
+    printf("final state %s with %d bad tries\n", state_names[output & 0x3], output >> 2);
+    if (seconds > 0) {
+        printf("%.0f records/s\n", records / seconds);
+    }
+    printf("%lu divergent steps\n", divergences);
+    return divergences ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ *
+ * @file telemetry-bench.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Measures the main-loop cost of the telemetry channel: what one
+ *      emit costs, what draining one record costs, and how many records a
+ *      second the channel sustains.
+ *
+ * Usage: <code>telemetry-bench [records] [capture.bin]</code>. The stream is
+ * written to `capture.bin` if one is given, so that it can be checked with
+ * the decoder.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "host-hal.h"
+#include "telemetry.h"
+
+#define DEFAULT_RECORDS     (1000000)
+#define SERIAL_BYTES_PER_S  (115200 / 10)
+
+static FILE *capture = NULL;
+static unsigned long long bytes = 0;
+
+static int unlimited_available_for_write(void) {
+    return 4096;
+}
+
+static void counting_write(uint8_t const *data, int length) {
+    bytes += length;
+    if (capture != NULL) {
+        fwrite(data, 1, length, capture);
+    }
+}
+
+static telemetry_sink_t const bench_sink = {
+        .available_for_write = unlimited_available_for_write,
+        .write = counting_write,
+};
+
+static void emit_one(unsigned long i) {
+    switch (i % 4) {
+        case 0:
+            emit_detent_telemetry((i & 4) ? 1 : -1);
+            break;
+        case 1:
+            emit_state_telemetry((uint8_t) (i % 3), (uint8_t) ((i + 1) % 3));
+            break;
+        case 2:
+            emit_servo_telemetry((i & 8) ? 500 : 2500);
+            break;
+        default:
+            emit_bad_tries_telemetry((uint8_t) (i % 3));
+            break;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned long records = (argc > 1) ? strtoul(argv[1], NULL, 10) : DEFAULT_RECORDS;
+    if (argc > 2) {
+        capture = fopen(argv[2], "wb");
+        if (capture == NULL) {
+            perror(argv[2]);
+            return 2;
+        }
+    }
+    initialize_host_hal();
+    initialize_telemetry(&bench_sink);
+    uint64_t emit_ns = 0;
+    uint64_t drain_ns = 0;
+    // emit in bursts of half a queue, then drain, as a busy loop() would
+    unsigned long emitted = 0;
+    while (emitted < records) {
+        service_host_timers();
+        uint32_t start = get_host_clock_ns();
+        for (int i = 0; i < TELEMETRY_QUEUE_LENGTH / 2 && emitted < records; i++) {
+            emit_one(emitted++);
+        }
+        uint32_t middle = get_host_clock_ns();
+        service_telemetry();
+        uint32_t end = get_host_clock_ns();
+        emit_ns += middle - start;
+        drain_ns += end - middle;
+    }
+    if (capture != NULL) {
+        fclose(capture);
+    }
+    telemetry_metrics_t metrics = get_telemetry_metrics();
+    double bytes_per_frame = (double) bytes / (metrics.frames_sent ? metrics.frames_sent : 1);
+    printf("%lu records, %lu frames, %llu bytes (%.1f bytes/frame), %lu dropped\n", (unsigned long) metrics.records,
+           (unsigned long) metrics.frames_sent, bytes, bytes_per_frame, (unsigned long) metrics.dropped_records);
+    printf("emit:  %.1f ns/record\n", (double) emit_ns / records);
+    printf("drain: %.1f ns/record (encode, CRC and write)\n", (double) drain_ns / records);
+    printf("CPU-bound throughput: %.0f records/s\n", records / ((emit_ns + drain_ns) / 1e9));
+    printf("at 115200 baud: %.0f records/s\n", SERIAL_BYTES_PER_S / bytes_per_frame);
+    return 0;
+}
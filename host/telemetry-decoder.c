@@ -0,0 +1,176 @@
+/**************************************************************************//**
+ *
+ * @file telemetry-decoder.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Decodes a telemetry stream captured from Serial (or written by the
+ *      native build) into one line per record.
+ *
+ * Run with <code>telemetry-decoder capture.bin</code>, or pipe the stream in.
+ * Text that was printed between frames is shown prefixed with "|"; frames that
+ * fail their CRC are counted and skipped, as are gaps in the sequence numbers.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include "telemetry.h"
+
+#define MAXIMUM_CHUNK   (256)
+
+static char const *state_names[] = {"LOCKED", "UNLOCKED", "CHANGING", "ALARMED"};
+
+static unsigned long frames = 0;
+static unsigned long bad_frames = 0;
+static unsigned long sequence_gaps = 0;
+static int expected_sequence = -1;
+static uint64_t timestamp_base_us = 0;
+static uint32_t last_timestamp_us = 0;
+
+static uint8_t crc8(uint8_t const *bytes, int length) {
+    uint8_t crc = 0;
+    for (int i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* Returns the decoded length, or -1 if the chunk is not valid COBS. */
+static int cobs_decode(uint8_t const *input, int length, uint8_t *output) {
+    int output_index = 0;
+    int i = 0;
+    while (i < length) {
+        uint8_t code = input[i++];
+        if (code == 0 || i + code - 1 > length) {
+            return -1;
+        }
+        for (int j = 1; j < code; j++) {
+            output[output_index++] = input[i++];
+        }
+        if (code != 0xFF && i < length) {
+            output[output_index++] = 0;
+        }
+    }
+    return output_index;
+}
+
+static uint32_t get_uint32(uint8_t const *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+static char const *state_name(uint8_t state) {
+    return (state < 4) ? state_names[state] : "?";
+}
+
+static void print_record(uint8_t const *record, int length) {
+    uint8_t type = record[0];
+    uint8_t sequence = record[1];
+    uint32_t timestamp_us = get_uint32(record + 2);
+    uint8_t const *payload = record + TELEMETRY_HEADER_SIZE;
+    int payload_length = length - TELEMETRY_HEADER_SIZE;
+    if (expected_sequence >= 0 && sequence != expected_sequence) {
+        sequence_gaps++;
+        printf("-- %d frame(s) missing --\n", (sequence - expected_sequence) & 0xFF);
+    }
+    expected_sequence = (sequence + 1) & 0xFF;
+    if (frames > 0 && timestamp_us < last_timestamp_us) {
+        timestamp_base_us += (uint64_t) 1 << 32;
+    }
+    last_timestamp_us = timestamp_us;
+    printf("%12.6f #%-3d ", (timestamp_base_us + timestamp_us) / 1e6, sequence);
+    frames++;
+    switch (type) {
+        case TELEMETRY_DETENT:
+            printf("detent %s", (payload_length >= 1 && payload[0] == CLOCKWISE) ? "clockwise" : "counterclockwise");
+            if (payload_length >= 2 && payload[1] != 1) {
+                printf(" x%d", payload[1]);
+            }
+            printf("\n");
+            break;
+        case TELEMETRY_STATE:
+            if (payload_length >= 2) {
+                printf("state %s -> %s\n", state_name(payload[0]), state_name(payload[1]));
+            }
+            break;
+        case TELEMETRY_BAD_TRIES:
+            printf("bad tries %d\n", payload_length >= 1 ? payload[0] : -1);
+            break;
+        case TELEMETRY_SERVO:
+            printf("servo %d us\n", payload_length >= 2 ? payload[0] | (payload[1] << 8) : -1);
+            break;
+        case TELEMETRY_LOOP:
+            if (payload_length >= 8) {
+                printf("loop %lu iterations/s, longest %lu us\n", (unsigned long) get_uint32(payload),
+                       (unsigned long) get_uint32(payload + 4));
+            }
+            break;
+        case TELEMETRY_DROPPED:
+            printf("%lu record(s) dropped on the device\n",
+                   payload_length >= 4 ? (unsigned long) get_uint32(payload) : 0);
+            break;
+        default:
+            printf("unknown type %d, %d payload bytes\n", type, payload_length);
+            break;
+    }
+}
+
+static bool is_text(uint8_t const *chunk, int length) {
+    for (int i = 0; i < length; i++) {
+        if (!isprint(chunk[i]) && !isspace(chunk[i])) {
+            return false;
+        }
+    }
+    return length > 0;
+}
+
+static void handle_chunk(uint8_t const *chunk, int length) {
+    uint8_t record[MAXIMUM_CHUNK];
+    if (length == 0) {
+        return;
+    }
+    int record_length = cobs_decode(chunk, length, record);
+    if (record_length > TELEMETRY_HEADER_SIZE && record_length <= TELEMETRY_HEADER_SIZE + TELEMETRY_MAXIMUM_PAYLOAD + 1
+        && crc8(record, record_length - 1) == record[record_length - 1]) {
+        print_record(record, record_length - 1);
+    } else if (is_text(chunk, length)) {
+        printf("| %.*s%s", length, (char const *) chunk, (chunk[length - 1] == '\n') ? "" : "\n");
+    } else {
+        bad_frames++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    FILE *input = stdin;
+    if (argc > 1) {
+        input = fopen(argv[1], "rb");
+        if (input == NULL) {
+            perror(argv[1]);
+            return 2;
+        }
+    }
+    uint8_t chunk[MAXIMUM_CHUNK];
+    int length = 0;
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        if (c == 0) {
+            handle_chunk(chunk, length);
+            length = 0;
+        } else if (length < MAXIMUM_CHUNK) {
+            chunk[length++] = (uint8_t) c;
+        }
+    }
+    handle_chunk(chunk, length);
+    fprintf(stderr, "%lu records, %lu bad frames, %lu sequence gaps\n", frames, bad_frames, sequence_gaps);
+    return bad_frames ? 1 : 0;
+}
@@ -0,0 +1,48 @@
+/**************************************************************************//**
+ *
+ * @file telemetry-sink.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The telemetry channel's host sink: a file named by the
+ *      COMBOLOCK_TELEMETRY environment variable.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "telemetry.h"
+
+// about what a USB CDC endpoint accepts at once
+#define HOST_SINK_SPACE     (64)
+
+static FILE *file = NULL;
+
+static int file_available_for_write(void) {
+    return HOST_SINK_SPACE;
+}
+
+static void file_write(uint8_t const *bytes, int length) {
+    fwrite(bytes, 1, length, file);
+}
+
+static telemetry_sink_t const file_sink = {
+        .available_for_write = file_available_for_write,
+        .write = file_write,
+};
+
+telemetry_sink_t const *get_telemetry_sink(void) {
+    char const *filename = getenv("COMBOLOCK_TELEMETRY");
+    if (file == NULL && filename != NULL) {
+        file = fopen(filename, "wb");
+        if (file == NULL) {
+            perror(filename);
+        }
+    }
+    return (file == NULL) ? NULL : &file_sink;
+}
@@ -0,0 +1,44 @@
+/**************************************************************************//**
+ *
+ * @file watchdog.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A stand-in for the RP2040's hardware watchdog. It cannot reset the
+ *      process; instead, the driver asks whether it would have.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "deadline-monitor.h"
+#include "host-hal.h"
+
+static bool running = false;
+static uint32_t timeout_us;
+static uint64_t last_kick_us;
+static uint32_t kicks = 0;
+
+void start_watchdog(uint32_t timeout_ms) {
+    running = true;
+    timeout_us = timeout_ms * 1000;
+    last_kick_us = get_host_time_us();
+}
+
+void kick_watchdog(void) {
+    last_kick_us = get_host_time_us();
+    kicks++;
+}
+
+bool host_watchdog_has_expired(void) {
+    return running && get_host_time_us() - last_kick_us > timeout_us;
+}
+
+uint32_t get_host_watchdog_kicks(void) {
+    return kicks;
+}
@@ -0,0 +1,63 @@
+/**************************************************************************//**
+ *
+ * @file boot-profiler.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to time the boot stages.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "boot-profiler.h"
+#include "deferred-work.h"
+#include "time-service.h"
+
+typedef struct {
+    char const *name;
+    uint32_t end_us;
+} boot_stage_t;
+
+static boot_stage_t stages[MAXIMUM_BOOT_STAGES];
+static uint8_t number_of_stages = 0;
+static uint32_t ready_us = 0;
+
+void mark_boot_stage(char const *name) {
+    if (number_of_stages < MAXIMUM_BOOT_STAGES) {
+        stages[number_of_stages++] = (boot_stage_t) {.name = name, .end_us = (uint32_t) get_time_us()};
+    }
+}
+
+static void report_when_idle(uint32_t unused) {
+    report_boot_profile();
+}
+
+void mark_boot_ready(void) {
+    if (ready_us == 0) {
+        ready_us = (uint32_t) get_time_us();
+        defer_work(WORK_PRIORITY_LOW, report_when_idle, 0);
+    }
+}
+
+uint32_t get_time_to_first_input(void) {
+    return ready_us;
+}
+
+void report_boot_profile(void) {
+    uint32_t previous = 0;
+    printf("boot:\n");
+    for (uint8_t i = 0; i < number_of_stages; i++) {
+        printf("  %-20s %8lu us\n", stages[i].name, (unsigned long) (stages[i].end_us - previous));
+        previous = stages[i].end_us;
+    }
+    if (ready_us != 0) {
+        printf("  %-20s %8lu us\n", "until tasks ran", (unsigned long) (ready_us - previous));
+        printf("first input %lu us after reset\n", (unsigned long) ready_us);
+    }
+}
@@ -0,0 +1,64 @@
+/**************************************************************************//**
+ *
+ * @file boot-profiler.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Timestamps for the stages of booting, up to the moment the lock
+ *      first looks at its inputs.
+ *
+ * setup() marks the end of each initialization stage with
+ * mark_boot_stage(); the first task to poll the inputs calls
+ * mark_boot_ready(). The times are measured from reset, so the first stage
+ * includes the core library's own startup. Work that the lock does not need
+ * in order to respond (splash screens, build timestamps, this report) is
+ * handed to the deferred-work queue at low priority, so it runs once the
+ * tasks are going.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_BOOT_PROFILER_H
+#define COMBOLOCK_BOOT_PROFILER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAXIMUM_BOOT_STAGES     (12)
+
+/**
+ * Records that the stage called `name` has just finished. Stages past
+ * MAXIMUM_BOOT_STAGES are not recorded.
+ */
+void mark_boot_stage(char const *name);
+
+/**
+ * Records that the lock is live, and queues report_boot_profile() as
+ * deferred work. Only the first call counts.
+ */
+void mark_boot_ready(void);
+
+/**
+ * @return Microseconds from reset until mark_boot_ready(), or 0 if it has
+ *      not been called
+ */
+uint32_t get_time_to_first_input(void);
+
+/**
+ * Prints each stage's duration and the time to first input.
+ */
+void report_boot_profile(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_BOOT_PROFILER_H
@@ -0,0 +1,77 @@
+/**************************************************************************//**
+ *
+ * @file combination-engine.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to instantiate the combination rules for this build's dial and
+ *      make them available to C code.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include "combination-engine.h"
+#include "combination-engine.hpp"
+
+typedef combolock::combination_engine<COMBOLOCK_DIAL_POSITIONS,
+        combolock::pass_counts<COMBOLOCK_REQUIRED_PASSES>> engine;
+
+static_assert(engine::length == COMBINATION_LENGTH,
+              "COMBOLOCK_REQUIRED_PASSES needs one count per number in the combination");
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void get_default_combination(uint8_t combination[]) {
+    for (unsigned i = 0; i < engine::length; i++) {
+        combination[i] = engine::default_number(i);
+    }
+}
+
+void clear_combination_entry(combination_entry_t *entry) {
+    engine::clear(*entry);
+}
+
+void turn_dial(combination_entry_t *entry, direction_t direction, uint8_t const combination[]) {
+    engine::turn(*entry, direction, combination);
+}
+
+void turn_dial_by(combination_entry_t *entry, int detents, uint8_t const combination[]) {
+    engine::turn_by(*entry, detents, combination);
+}
+
+bool combination_entry_is_final(combination_entry_t const *entry) {
+    return engine::is_final(*entry);
+}
+
+bool combination_entry_matches(combination_entry_t const *entry, uint8_t const combination[]) {
+    return engine::matches(*entry, combination);
+}
+
+void get_displayed_numbers(combination_entry_t const *entry, uint8_t numbers[]) {
+    for (unsigned i = 0; i < engine::length; i++) {
+        numbers[i] = (i == entry->entry_stage) ? entry->current_number : entry->entered_combination[i];
+    }
+}
+
+void clear_new_combination(new_combination_t *new_combination) {
+    engine::clear_new(*new_combination);
+}
+
+void enter_new_combination_digit(new_combination_t *new_combination, uint8_t digit) {
+    engine::enter_digit(*new_combination, digit);
+}
+
+bool new_combination_is_acceptable(new_combination_t const *new_combination) {
+    return engine::is_acceptable(*new_combination);
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
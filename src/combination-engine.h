@@ -0,0 +1,154 @@
+/**************************************************************************//**
+ *
+ * @file combination-engine.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The dial-turning and combination-checking rules of the lock, for a
+ *      dial size and combination length chosen at compile time.
+ *
+ * Build with, for example,
+ * <code>-DCOMBOLOCK_DIAL_POSITIONS=40 -DCOMBOLOCK_COMBINATION_LENGTH=4</code>
+ * for a 40-position dial with a 4-number combination. The number of times
+ * each number must be passed can be given with
+ * <code>-DCOMBOLOCK_REQUIRED_PASSES=...</code>; the first count is a minimum
+ * and the rest are exact.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_COMBINATION_ENGINE_H
+#define COMBOLOCK_COMBINATION_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rotary-encoder.h"
+
+#ifndef COMBOLOCK_DIAL_POSITIONS
+#define COMBOLOCK_DIAL_POSITIONS        (16)
+#endif
+
+#ifndef COMBOLOCK_COMBINATION_LENGTH
+#define COMBOLOCK_COMBINATION_LENGTH    (3)
+#endif
+
+#ifndef COMBOLOCK_REQUIRED_PASSES
+#if COMBOLOCK_COMBINATION_LENGTH == 2
+#define COMBOLOCK_REQUIRED_PASSES       2, 1
+#elif COMBOLOCK_COMBINATION_LENGTH == 3
+#define COMBOLOCK_REQUIRED_PASSES       3, 2, 1
+#elif COMBOLOCK_COMBINATION_LENGTH == 4
+#define COMBOLOCK_REQUIRED_PASSES       4, 3, 2, 1
+#elif COMBOLOCK_COMBINATION_LENGTH == 5
+#define COMBOLOCK_REQUIRED_PASSES       5, 4, 3, 2, 1
+#elif COMBOLOCK_COMBINATION_LENGTH == 6
+#define COMBOLOCK_REQUIRED_PASSES       6, 5, 4, 3, 2, 1
+#else
+#error "COMBOLOCK_REQUIRED_PASSES must be specified for this COMBOLOCK_COMBINATION_LENGTH"
+#endif
+#endif
+
+#define COMBINATION_LENGTH              (COMBOLOCK_COMBINATION_LENGTH)
+#define NEW_COMBINATION_LENGTH          (2 * COMBOLOCK_COMBINATION_LENGTH)
+#define NO_NUMBER                       (0xFF)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The progress of someone dialing a combination.
+ */
+typedef struct {
+    uint8_t current_number;
+    uint8_t entry_stage;
+    direction_t correct_direction;
+    uint8_t entered_combination[COMBINATION_LENGTH];
+    uint8_t visible_counts[COMBINATION_LENGTH];
+} combination_entry_t;
+
+/**
+ * A new combination typed on the keypad, followed by its confirmation, two
+ * digits per number.
+ */
+typedef struct {
+    uint8_t numbers[NEW_COMBINATION_LENGTH];
+    uint8_t digit_index;
+} new_combination_t;
+
+/**
+ * Fills `combination` with the factory-default combination.
+ */
+void get_default_combination(uint8_t combination[]);
+
+/**
+ * Returns the dial to 0 and forgets any numbers that have been dialed.
+ */
+void clear_combination_entry(combination_entry_t *entry);
+
+/**
+ * Applies one detent of rotation. Turning the wrong way moves on to the next
+ * number; turning the wrong way on the last number starts over.
+ *
+ * @param entry The combination being dialed
+ * @param direction The direction of the detent
+ * @param combination The lock's combination, used to count visible passes
+ */
+void turn_dial(combination_entry_t *entry, direction_t direction, uint8_t const combination[]);
+
+/**
+ * Applies a net rotation of several detents at once, with the same result as
+ * applying them one at a time with turn_dial().
+ *
+ * @param entry The combination being dialed
+ * @param detents The net rotation: positive clockwise, negative
+ *      counterclockwise
+ * @param combination The lock's combination, used to count visible passes
+ */
+void turn_dial_by(combination_entry_t *entry, int detents, uint8_t const combination[]);
+
+/**
+ * @return <code>true</code> if the last number of the combination is being
+ *      dialed; <code>false</code> otherwise
+ */
+bool combination_entry_is_final(combination_entry_t const *entry);
+
+/**
+ * @return <code>true</code> if every number matches the combination and was
+ *      passed the required number of times; <code>false</code> otherwise
+ */
+bool combination_entry_matches(combination_entry_t const *entry, uint8_t const combination[]);
+
+/**
+ * Fills `numbers` with what the display should show for each number: the
+ * dial position for the number being dialed, the dialed number for earlier
+ * ones, and NO_NUMBER for later ones.
+ */
+void get_displayed_numbers(combination_entry_t const *entry, uint8_t numbers[]);
+
+/**
+ * Forgets any digits typed for a new combination.
+ */
+void clear_new_combination(new_combination_t *new_combination);
+
+/**
+ * Adds one keypad digit to the new combination; extra digits are ignored.
+ */
+void enter_new_combination_digit(new_combination_t *new_combination, uint8_t digit);
+
+/**
+ * @return <code>true</code> if the new combination is complete, matches its
+ *      confirmation, and is on the dial; <code>false</code> otherwise
+ */
+bool new_combination_is_acceptable(new_combination_t const *new_combination);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_COMBINATION_ENGINE_H
@@ -0,0 +1,264 @@
+/**************************************************************************//**
+ *
+ * @file combination-engine.hpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The combination rules as a template over the dial size and the
+ *      required pass counts, so that every configuration is resolved at
+ *      compile time.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_COMBINATION_ENGINE_HPP
+#define COMBOLOCK_COMBINATION_ENGINE_HPP
+
+#include <stdint.h>
+#include "rotary-encoder.h"
+
+namespace combolock {
+
+/* A number of detents as whole laps of the dial and the detents left over. */
+struct dial_laps {
+    unsigned laps;
+    unsigned detents;
+};
+
+/* Stepping around the dial. Dials whose size is a power of two wrap with a
+ * mask and split a turn into laps with a shift; other dials wrap with a
+ * compare-and-select and split a turn by shift-and-subtract, since the
+ * Cortex-M0+ has no divide instruction. */
+template<unsigned Positions, bool = ((Positions & (Positions - 1)) == 0)>
+struct dial_arithmetic {
+    static constexpr uint8_t next(uint8_t number) {
+        return (number == Positions - 1) ? 0 : (uint8_t) (number + 1);
+    }
+
+    static constexpr uint8_t previous(uint8_t number) {
+        return (number == 0) ? (uint8_t) (Positions - 1) : (uint8_t) (number - 1);
+    }
+
+    // the number `steps` detents clockwise of `number`, for `steps` up to Positions
+    static constexpr uint8_t forward(uint8_t number, unsigned steps) {
+        return (number + steps >= Positions) ? (uint8_t) (number + steps - Positions) : (uint8_t) (number + steps);
+    }
+
+    // the number `steps` detents counterclockwise of `number`, for `steps` up to Positions
+    static constexpr uint8_t backward(uint8_t number, unsigned steps) {
+        return (number >= steps) ? (uint8_t) (number - steps) : (uint8_t) (number + Positions - steps);
+    }
+
+    // the number of detents clockwise from `from` to `to`, in [0, Positions)
+    static constexpr unsigned distance(uint8_t from, uint8_t to) {
+        return (to >= from) ? (unsigned) (to - from) : (unsigned) (to + Positions - from);
+    }
+
+    // the largest shift of Positions that still fits in an unsigned
+    static constexpr unsigned top_shift(unsigned shift = 0) {
+        return ((Positions << shift) > (~0u >> 1)) ? shift : top_shift(shift + 1);
+    }
+
+    // one compare and subtract per bit of the quotient
+    static constexpr dial_laps split(unsigned steps) {
+        dial_laps result = {0, steps};
+        for (unsigned shift = top_shift() + 1; shift-- > 0;) {
+            if (result.detents >= (Positions << shift)) {
+                result.detents -= Positions << shift;
+                result.laps |= 1u << shift;
+            }
+        }
+        return result;
+    }
+};
+
+template<unsigned Positions>
+struct dial_arithmetic<Positions, true> {
+    static constexpr uint8_t next(uint8_t number) {
+        return (uint8_t) ((number + 1) & (Positions - 1));
+    }
+
+    static constexpr uint8_t previous(uint8_t number) {
+        return (uint8_t) ((number - 1) & (Positions - 1));
+    }
+
+    static constexpr uint8_t forward(uint8_t number, unsigned steps) {
+        return (uint8_t) ((number + steps) & (Positions - 1));
+    }
+
+    static constexpr uint8_t backward(uint8_t number, unsigned steps) {
+        return (uint8_t) ((number - steps) & (Positions - 1));
+    }
+
+    static constexpr unsigned distance(uint8_t from, uint8_t to) {
+        return (unsigned) (to - from) & (Positions - 1);
+    }
+
+    static constexpr unsigned lap_shift(unsigned value = Positions) {
+        return (value == 1) ? 0 : 1 + lap_shift(value >> 1);
+    }
+
+    static constexpr dial_laps split(unsigned steps) {
+        return {steps >> lap_shift(), steps & (Positions - 1)};
+    }
+};
+
+/* How many times each number must be seen go by: at least the first count for
+ * the first number, exactly the given count for each later number. */
+template<uint8_t... Counts>
+struct pass_counts {
+    static constexpr unsigned length = sizeof...(Counts);
+    static constexpr uint8_t values[length] = {Counts...};
+};
+
+template<uint8_t... Counts>
+constexpr uint8_t pass_counts<Counts...>::values[];
+
+template<unsigned Positions, typename Passes>
+struct combination_engine {
+    static constexpr unsigned dial_positions = Positions;
+    static constexpr unsigned length = Passes::length;
+    typedef dial_arithmetic<Positions> dial;
+
+    static_assert(Positions >= 2 && Positions <= 100, "dial numbers are entered and shown as two digits");
+    static_assert(length >= 2, "a combination needs at least two numbers");
+
+    static constexpr uint8_t default_number(unsigned index) {
+        return (uint8_t) ((5 * (index + 1)) % Positions);
+    }
+
+    template<typename Entry>
+    static void clear(Entry &entry) {
+        entry.entry_stage = 0;
+        entry.current_number = 0;
+        entry.correct_direction = CLOCKWISE;
+        for (unsigned i = 0; i < length; i++) {
+            entry.entered_combination[i] = 0xFF;
+            entry.visible_counts[i] = 0;
+        }
+    }
+
+    template<typename Entry>
+    static void turn(Entry &entry, direction_t direction, uint8_t const combination[]) {
+        unsigned stage = entry.entry_stage;
+        if (direction == STATIONARY) {
+            // nothing moved
+        } else if (direction == entry.correct_direction) {
+            uint8_t number = (direction == CLOCKWISE) ? dial::next(entry.current_number)
+                                                      : dial::previous(entry.current_number);
+            if (number == combination[stage] && entry.visible_counts[stage] < 0xFF) {
+                entry.visible_counts[stage]++;
+            }
+            entry.current_number = number;
+        } else if (stage + 1 < length) {
+            entry.entry_stage = (uint8_t) ++stage;
+            entry.correct_direction = direction;
+        } else {
+            clear(entry);
+            return;
+        }
+        entry.entered_combination[stage] = entry.current_number;
+    }
+
+    /* Applies a net rotation of `detents` (positive clockwise) as turn() would
+     * one detent at a time: a leading wrong-way detent changes the stage (at
+     * most twice, if it starts over), and the rest move the dial in one step,
+     * counting every pass of the stage's number along the way. */
+    template<typename Entry>
+    static void turn_by(Entry &entry, int detents, uint8_t const combination[]) {
+        if (detents == 0) {
+            return;
+        }
+        direction_t direction = (detents > 0) ? CLOCKWISE : COUNTERCLOCKWISE;
+        unsigned steps = (detents > 0) ? (unsigned) detents : (unsigned) -detents;
+        while (steps > 0 && direction != entry.correct_direction) {
+            turn(entry, direction, combination);
+            steps--;
+        }
+        if (steps == 0) {
+            return;
+        }
+        unsigned stage = entry.entry_stage;
+        uint8_t current = entry.current_number;
+        uint8_t target = combination[stage];
+        // detents until the dial first lands on the target, then once more every lap
+        unsigned first_pass = (direction == CLOCKWISE) ? dial::distance(current, target)
+                                                       : dial::distance(target, current);
+        if (first_pass == 0) {
+            first_pass = Positions;
+        }
+        if (steps >= first_pass) {
+            unsigned passes = entry.visible_counts[stage] + 1 + dial::split(steps - first_pass).laps;
+            entry.visible_counts[stage] = (uint8_t) ((passes < 0xFF) ? passes : 0xFF);
+        }
+        unsigned leftover = dial::split(steps).detents;
+        entry.current_number = (direction == CLOCKWISE) ? dial::forward(current, leftover)
+                                                        : dial::backward(current, leftover);
+        entry.entered_combination[stage] = entry.current_number;
+    }
+
+    template<typename Entry>
+    static bool is_final(Entry const &entry) {
+        return entry.entry_stage == length - 1;
+    }
+
+    template<typename Entry>
+    static bool matches(Entry const &entry, uint8_t const combination[]) {
+        for (unsigned i = 0; i < length; i++) {
+            if (entry.entered_combination[i] != combination[i]) {
+                return false;
+            }
+        }
+        if (entry.visible_counts[0] < Passes::values[0]) {
+            return false;
+        }
+        for (unsigned i = 1; i < length; i++) {
+            if (entry.visible_counts[i] != Passes::values[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename NewCombination>
+    static void clear_new(NewCombination &new_combination) {
+        new_combination.digit_index = 0;
+        for (unsigned i = 0; i < 2 * length; i++) {
+            new_combination.numbers[i] = 0xFF;
+        }
+    }
+
+    template<typename NewCombination>
+    static void enter_digit(NewCombination &new_combination, uint8_t digit) {
+        unsigned index = new_combination.digit_index;
+        if (index >= 2 * length) {
+            return;
+        }
+        if (new_combination.numbers[index] == 0xFF) {
+            new_combination.numbers[index] = (uint8_t) (10 * digit);
+        } else {
+            new_combination.numbers[index] += digit;
+            new_combination.digit_index++;
+        }
+    }
+
+    template<typename NewCombination>
+    static bool is_acceptable(NewCombination const &new_combination) {
+        for (unsigned i = 0; i < length; i++) {
+            uint8_t number = new_combination.numbers[i];
+            if (number == 0xFF || number >= Positions || number != new_combination.numbers[i + length]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace combolock
+
+#endif //COMBOLOCK_COMBINATION_ENGINE_HPP
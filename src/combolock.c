@@ -21,50 +21,240 @@
 
 
 #include <CowPi.h>
+#include "boot-profiler.h"
+#include "combination-engine.h"
+#include "console.h"
+#include "deadline-monitor.h"
+#include "deferred-work.h"
 #include "display.h"
+#include "display-core.h"
+#include "input-events.h"
+#include "input-journal.h"
+#include "keypad.h"
+#include "profiler.h"
 #include "rotary-encoder.h"
+#include "self-bench.h"
 #include "servomotor.h"
+#include "stack-monitor.h"
+#include "telemetry.h"
 #include "lock-controller.h"
+#include "pending-work.h"
+#include "task-scheduler.h"
+#include "time-service.h"
 
 static bool test_mode;
+static bool showing_bench = false;
+static char servo_buffer[22] = {0};
 
+static void show_test_rows(void) {
+    static char rotations_buffer[22] = {0};
+    static char combo_buffer[32] = {0};
+    count_rotations(rotations_buffer);
+    display_string(1, rotations_buffer);
+    test_servo(servo_buffer);
+    display_string(2, servo_buffer);
+    uint8_t const *combination = get_combination();
+    strcpy(combo_buffer, "Combo:");
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        sprintf(combo_buffer + strlen(combo_buffer), (i == 0) ? " %02d" : "-%02d", combination[i]);
+    }
+    display_string(3, combo_buffer);
+}
+
+static void bench_iteration(void) {
+    show_test_rows();
+    refresh_display();
+    count_visits(7);
+}
+
+/* How long tasks wait, at most, between runs; the events they await usually
+ * wake them sooner. */
+#define LOCK_HOUSEKEEPING_US    (10000)     // settings writes continue without input
+#define TEST_MODE_PERIOD_US     (20000)
+#define DISPLAY_PERIOD_US       (40000)     // the I2C transfer alone takes about 23ms
+#define DEFERRED_WORK_PERIOD_US (10000)     // picks up what did not fit in the previous slice
+
+static task_status_t lock_task(task_t *task) {
+    TASK_BEGIN(task);
+    mark_boot_ready();
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_CONTROL_LOCK);
+            control_lock();
+        }
+        TASK_AWAIT_EVENTS(task, WORK_DETENT | WORK_INPUT | WORK_KEYPAD | WORK_LEDS | WORK_TICK,
+                          LOCK_HOUSEKEEPING_US);
+    }
+    TASK_END(task);
+}
+
+static task_status_t test_mode_task(task_t *task) {
+    TASK_BEGIN(task);
+    mark_boot_ready();
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_TEST_MODE);
+            if (showing_bench) {
+                test_servo(servo_buffer);
+            } else {
+                show_test_rows();
+            }
+            input_event_t event;
+            while (get_input_event(&event)) {
+                if (event.input == RIGHT_BUTTON && event.type == INPUT_PRESSED) {
+                    force_combination_reset();
+                }
+            }
+            // the buttons and dial belong to the servo and rotation tests, so the bench is on the keypad
+            keypad_event_t key_event;
+            while (get_keypad_event(&key_event)) {
+                if (key_event.pressed && key_event.key == '#') {
+                    run_self_bench(bench_iteration, 1);
+                    showing_bench = true;
+                } else if (key_event.pressed && key_event.key == '*') {
+                    showing_bench = false;
+                }
+            }
+        }
+        TASK_AWAIT_EVENTS(task, WORK_INPUT | WORK_KEYPAD, TEST_MODE_PERIOD_US);
+    }
+    TASK_END(task);
+}
+
+static task_status_t deferred_work_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_BACKGROUND);
+            run_deferred_work(DEFERRED_WORK_SLICE_US);
+        }
+        TASK_AWAIT_EVENTS(task, WORK_DEFERRED, DEFERRED_WORK_PERIOD_US);
+    }
+    TASK_END(task);
+}
+
+static task_status_t display_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        PROFILE_REPORT((test_mode && !showing_bench) ? 4 : -1);
+        {
+            // count_visits() refreshes the display, so one transfer per period is enough
+            PROFILE_ZONE(PROFILE_REFRESH_DISPLAY);
+            count_visits(7);
+        }
+        TASK_DELAY(task, DISPLAY_PERIOD_US);
+    }
+    TASK_END(task);
+}
+
+static task_status_t stack_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_BACKGROUND);
+            scan_stacks();
+        }
+        TASK_DELAY(task, STACK_SCAN_PERIOD_MS * 1000);
+    }
+    TASK_END(task);
+}
+
+static void run_bench_command(char const *arguments) {
+    // test mode has rows to spare for the report; the lock's screen does not
+    run_self_bench(bench_iteration, test_mode ? 1 : -1);
+    showing_bench = test_mode;
+}
+
+static void run_journal_command(char const *arguments) {
+    dump_input_journal();
+}
+
+static task_status_t console_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_BACKGROUND);
+            service_console(CONSOLE_SLICE_US);
+        }
+        TASK_DELAY(task, CONSOLE_POLL_PERIOD_US);
+    }
+    TASK_END(task);
+}
+
+static task_status_t telemetry_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        {
+            PROFILE_ZONE(PROFILE_BACKGROUND);
+            service_telemetry();
+        }
+        TASK_YIELD(task);
+    }
+    TASK_END(task);
+}
+
+static void show_build_timestamp(uint32_t unused) {
+    print_build_timestamps(true);
+}
+
+/* Only what the lock needs in order to respond runs here; the display task
+ * paints the first screen, and the rest is deferred work. */
 void setup() {
+    mark_boot_stage("core library");
+    initialize_stack_monitor();
     record_build_timestamp(__FILE__, __DATE__, __TIME__);
     cowpi_setup(0,
                 (cowpi_display_module_t) {.display_module = NO_MODULE},
                 (cowpi_display_module_protocol_t) {.protocol = NO_PROTOCOL}
                );
-    initialize_display(21);
+    mark_boot_stage("cowpi_setup");
+    configure_display(21);
+    mark_boot_stage("display");
     initialize_rotary_encoder();
     initialize_servo();
+    mark_boot_stage("encoder and servo");
     initialize_lock_controller();
-    print_build_timestamps(true);
+    mark_boot_stage("lock controller");
     test_mode = cowpi_right_switch_is_in_left_position();
-}
-
-void loop() {
+    initialize_task_scheduler();
     if (test_mode) {
-        static char rotations_buffer[22] = {0};
-        static char servo_buffer[22] = {0};
-        static char combo_buffer[22] = {0};
-        count_rotations(rotations_buffer);
-        display_string(1, rotations_buffer);
-        test_servo(servo_buffer);
-        display_string(2, servo_buffer);
-        uint8_t const *combination = get_combination();
-        sprintf(combo_buffer, "Combo: %02d-%02d-%02d", combination[0], combination[1], combination[2]);
-        display_string(3, combo_buffer);
-        static bool is_pressed = false;
-        if (cowpi_right_button_is_pressed() && !is_pressed) {
-            is_pressed = true;
-            force_combination_reset();
-        }
-        if (!cowpi_right_button_is_pressed() && is_pressed) {
-            is_pressed = false;
-        }
+        start_task(test_mode_task, "test mode", SUBSYSTEM_TEST_MODE);
     } else {
-        control_lock();
+        start_task(lock_task, "lock", SUBSYSTEM_CONTROL_LOCK);
     }
-    refresh_display();
-    count_visits(7);
-}
\ No newline at end of file
+    start_task(deferred_work_task, "deferred work", SUBSYSTEM_DEFERRED_WORK);
+    start_task(display_task, "display", SUBSYSTEM_DISPLAY);
+    start_task(telemetry_task, "telemetry", SUBSYSTEM_TELEMETRY);
+    start_task(stack_task, "stacks", SUBSYSTEM_HOUSEKEEPING);
+    initialize_console(get_console_port());
+    register_console_command("bench", run_bench_command, "runs the self-bench");
+    register_console_command("journal", run_journal_command, "prints the input journal for replay");
+    start_task(console_task, "console", SUBSYSTEM_HOUSEKEEPING);
+    mark_boot_stage("tasks and console");
+    initialize_deadline_monitor(COMBOLOCK_LOOP_BUDGET_US);
+#ifdef COMBOLOCK_TICKLESS
+    initialize_pending_work();
+#endif
+#ifdef COMBOLOCK_DUAL_CORE
+    start_display_core();
+#endif
+    mark_boot_stage("monitors");
+    defer_work(WORK_PRIORITY_LOW, show_build_timestamp, 0);
+}
+
+/* When the tasks next need to run without an event, for the tickless build;
+ * 0 lets the first pass run at once. */
+static uint32_t next_wake_us = 0;
+
+void loop() {
+#ifdef COMBOLOCK_TICKLESS
+    uint32_t events = wait_for_work(next_wake_us);
+    report_idle_time();
+#else
+    uint32_t events = take_work();
+#endif
+    PROFILE_LOOP();
+    start_loop_iteration();
+    next_wake_us = run_tasks(events, (uint32_t) get_time_us());
+    end_loop_iteration();
+}
@@ -0,0 +1,42 @@
+/**************************************************************************//**
+ *
+ * @file console-serial.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The console's view of the Serial port.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "console.h"
+
+#ifdef __MBED__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int serial_read(void) {
+    return Serial.available() ? Serial.read() : -1;
+}
+
+static console_port_t const serial_port = {
+        .read = serial_read,
+};
+
+console_port_t const *get_console_port(void) {
+    return &serial_port;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //__MBED__
@@ -0,0 +1,190 @@
+/**************************************************************************//**
+ *
+ * @file console.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to parse console lines and run the commands.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "boot-profiler.h"
+#include "console.h"
+#include "deadline-monitor.h"
+#include "deferred-work.h"
+#include "display.h"
+#include "display-core.h"
+#include "flight-recorder.h"
+#include "input-events.h"
+#include "keypad.h"
+#include "lock-status.h"
+#include "stack-monitor.h"
+#include "task-scheduler.h"
+#include "time-service.h"
+
+typedef struct {
+    char const *name;
+    console_handler_t handler;
+    char const *help;
+} console_command_t;
+
+static console_port_t const *port = NULL;
+static console_command_t commands[MAXIMUM_CONSOLE_COMMANDS];
+static uint8_t number_of_commands = 0;
+static char line[CONSOLE_LINE_LENGTH + 1];
+static uint8_t line_length = 0;
+static bool line_overflowed = false;
+
+static void show_help(char const *arguments) {
+    for (uint8_t i = 0; i < number_of_commands; i++) {
+        printf("  %-8s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+static void show_stats(char const *arguments) {
+    deadline_metrics_t deadlines = get_deadline_metrics();
+    printf("loop: %lu iterations, %lu over budget, worst %lu us (%s)\n", (unsigned long) deadlines.iterations,
+           (unsigned long) deadlines.overruns, (unsigned long) deadlines.worst_iteration_us,
+           get_subsystem_name((loop_subsystem_t) deadlines.worst_subsystem));
+    scheduler_metrics_t scheduler = get_scheduler_metrics();
+    printf("tasks: %lu passes, %lu runs\n", (unsigned long) scheduler.passes, (unsigned long) scheduler.resumptions);
+    keypad_metrics_t keypad;
+    get_keypad_metrics(&keypad);
+    printf("keypad: %lu scans, %lu events, %lu dropped, %lu bounces\n", (unsigned long) keypad.scans,
+           (unsigned long) keypad.events, (unsigned long) keypad.dropped_events,
+           (unsigned long) keypad.rejected_bounces);
+    printf("inputs: %lu dropped\n", (unsigned long) get_dropped_input_events());
+    deferred_queue_stats_t deferred[NUMBER_OF_WORK_PRIORITIES];
+    get_deferred_work_stats(deferred);
+    for (int i = 0; i < NUMBER_OF_WORK_PRIORITIES; i++) {
+        printf("deferred %d: %lu posted, %lu run, %lu refused\n", i, (unsigned long) deferred[i].posted,
+               (unsigned long) deferred[i].run, (unsigned long) deferred[i].overflows);
+    }
+    printf("display: %lu refreshes\n", (unsigned long) get_display_refreshes());
+#ifdef COMBOLOCK_DUAL_CORE
+    display_core_metrics_t display_core = get_display_core_metrics();
+    printf("display core: %lu published, %lu rendered, %lu retries\n", (unsigned long) display_core.published,
+           (unsigned long) display_core.rendered, (unsigned long) display_core.retries);
+#endif
+    for (int i = 0; i < NUMBER_OF_STACKS; i++) {
+        stack_usage_t stack = get_stack_usage((stack_id_t) i);
+        if (stack.size_bytes > 0) {
+            printf("%s stack: %lu of %lu bytes\n", get_stack_name((stack_id_t) i),
+                   (unsigned long) stack.high_water_bytes, (unsigned long) stack.size_bytes);
+        }
+    }
+    printf("uptime: %lu ms\n", (unsigned long) get_time_ms());
+}
+
+static void show_state(char const *arguments) {
+    lock_status_t status = get_lock_status();
+    printf("%s, entry stage %d, %d bad tries\n", status.state, status.entry_stage, status.bad_tries);
+}
+
+static void show_trace(char const *arguments) {
+    dump_flight_recorder();
+}
+
+static void show_boot(char const *arguments) {
+    report_boot_profile();
+}
+
+void initialize_console(console_port_t const *console_port) {
+    port = console_port;
+    number_of_commands = 0;
+    line_length = 0;
+    line_overflowed = false;
+    register_console_command("help", show_help, "lists the commands");
+    register_console_command("stats", show_stats, "loop, task, ISR and display counters");
+    register_console_command("state", show_state, "lock state, entry stage and bad tries");
+    register_console_command("trace", show_trace, "recent events from the flight recorder");
+    register_console_command("boot", show_boot, "how long each stage of booting took");
+}
+
+bool register_console_command(char const *name, console_handler_t handler, char const *help) {
+    uint8_t i = 0;
+    while (i < number_of_commands && strcmp(commands[i].name, name)) {
+        i++;
+    }
+    if (i == MAXIMUM_CONSOLE_COMMANDS) {
+        return false;
+    }
+    commands[i] = (console_command_t) {.name = name, .handler = handler, .help = help};
+    if (i == number_of_commands) {
+        number_of_commands++;
+    }
+    return true;
+}
+
+static void run_line(void) {
+    char *name = line;
+    while (*name == ' ') {
+        name++;
+    }
+    char *arguments = name;
+    while (*arguments != '\0' && *arguments != ' ') {
+        arguments++;
+    }
+    if (*arguments != '\0') {
+        *arguments++ = '\0';
+        while (*arguments == ' ') {
+            arguments++;
+        }
+    }
+    for (uint8_t i = 0; i < number_of_commands; i++) {
+        if (!strcmp(commands[i].name, name)) {
+            commands[i].handler(arguments);
+            return;
+        }
+    }
+    printf("unknown command \"%s\"; try help\n", name);
+}
+
+/* Adds a byte to the line. @return true if it completed a non-empty line */
+static bool take_byte(char byte) {
+    if (byte == '\r' || byte == '\n') {
+        bool complete = line_length > 0 && !line_overflowed;
+        if (line_overflowed) {
+            printf("line too long; the limit is %d characters\n", CONSOLE_LINE_LENGTH);
+        }
+        line[line_length] = '\0';
+        line_length = 0;
+        line_overflowed = false;
+        return complete;
+    }
+    if (byte == '\b' || byte == 0x7F) {
+        if (line_length > 0) {
+            line_length--;
+        }
+    } else if (line_length == CONSOLE_LINE_LENGTH) {
+        line_overflowed = true;
+    } else if (byte >= ' ' && byte <= '~') {
+        line[line_length++] = byte;
+    }
+    return false;
+}
+
+bool service_console(uint32_t budget_us) {
+    if (port == NULL) {
+        return false;
+    }
+    uint64_t start = get_time_us();
+    int byte;
+    while ((byte = port->read()) >= 0) {
+        if (take_byte((char) byte)) {
+            run_line();
+            return true;
+        }
+        if (get_time_us() - start >= budget_us) {
+            break;
+        }
+    }
+    return false;
+}
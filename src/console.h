@@ -0,0 +1,82 @@
+/**************************************************************************//**
+ *
+ * @file console.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A line-oriented command console on the Serial port, for looking
+ *      into a running lock without reflashing it.
+ *
+ * service_console() is called from loop() and never waits for input: it
+ * takes whatever bytes have arrived, adding them to the current line, until
+ * none are left or its time slice is used up. When a line is complete, its
+ * first word picks the command and the rest of the line is the command's
+ * arguments; at most one command runs per call, and replies go out with
+ * printf(). Backspace and delete erase the previous character, and an empty
+ * line is ignored, so both CR and CRLF line endings work.
+ *
+ * The built-in commands are <code>help</code>, <code>stats</code>,
+ * <code>state</code>, <code>trace</code> and <code>boot</code>; other modules add theirs with
+ * register_console_command().
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_CONSOLE_H
+#define COMBOLOCK_CONSOLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONSOLE_LINE_LENGTH         (40)
+#define MAXIMUM_CONSOLE_COMMANDS    (8)
+#define CONSOLE_SLICE_US            (200)
+#define CONSOLE_POLL_PERIOD_US      (10000)     // about 115 bytes arrive in this time at 115200 baud
+
+typedef struct {
+    /** @return The next received byte, or -1 if there is none */
+    int (*read)(void);
+} console_port_t;
+
+typedef void (*console_handler_t)(char const *arguments);
+
+/**
+ * @param port Where the console reads from; NULL disables the console
+ */
+void initialize_console(console_port_t const *port);
+
+/**
+ * Adds a command. A command with the name of an existing one replaces it.
+ *
+ * @return <code>false</code> if there are already MAXIMUM_CONSOLE_COMMANDS
+ *      commands
+ */
+bool register_console_command(char const *name, console_handler_t handler, char const *help);
+
+/**
+ * Reads and parses received bytes for up to `budget_us` microseconds, and
+ * runs the first command completed.
+ *
+ * @return <code>true</code> if a command ran
+ */
+bool service_console(uint32_t budget_us);
+
+/**
+ * @return The Serial port on the RP2040; standard input on the host
+ */
+console_port_t const *get_console_port(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_CONSOLE_H
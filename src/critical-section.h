@@ -0,0 +1,63 @@
+/**************************************************************************//**
+ *
+ * @file critical-section.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Masking interrupts around the few stores that an ISR must not see
+ *      half-done.
+ *
+ * The RP2040's Cortex-M0+ cores have no exclusive loads and stores, so a
+ * read-modify-write shared with an ISR is made atomic by setting PRIMASK, and
+ * then restoring it so that critical sections nest. Keep them to a handful of
+ * instructions. On the host, ISRs never preempt the main loop, so these do
+ * nothing.
+ *
+ * A single-producer queue needs no critical section, only the order of its
+ * accesses: memory_barrier() keeps the stores that fill a slot ahead of the
+ * store that publishes it, and the loads of a slot behind the load that
+ * found it published.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_CRITICAL_SECTION_H
+#define COMBOLOCK_CRITICAL_SECTION_H
+
+#include <stdint.h>
+
+#ifdef __MBED__
+static inline uint32_t disable_interrupts(void) {
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) : : "memory");
+    return primask;
+}
+
+static inline void restore_interrupts(uint32_t primask) {
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+
+static inline void memory_barrier(void) {
+    __asm volatile ("dmb" : : : "memory");
+}
+#else
+static inline uint32_t disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t primask) {
+    (void) primask;
+}
+
+// the compiler is the only thing that could reorder these on the host
+static inline void memory_barrier(void) {
+    __asm volatile ("" : : : "memory");
+}
+#endif //__MBED__
+
+#endif //COMBOLOCK_CRITICAL_SECTION_H
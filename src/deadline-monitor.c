@@ -0,0 +1,82 @@
+/**************************************************************************//**
+ *
+ * @file deadline-monitor.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to hold loop() iterations to a budget and feed the watchdog.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "deadline-monitor.h"
+#include "flight-recorder.h"
+#include "time-service.h"
+
+static char const *subsystem_names[NUMBER_OF_SUBSYSTEMS] = {
+        "control_lock", "test mode", "display", "telemetry", "deferred work", "housekeeping"
+};
+
+static uint32_t budget_us;
+static uint64_t iteration_start;
+static uint64_t checkpoint;
+static uint32_t subsystem_us[NUMBER_OF_SUBSYSTEMS];
+static deadline_metrics_t metrics;
+
+void initialize_deadline_monitor(uint32_t budget) {
+    budget_us = budget;
+    memset(&metrics, 0, sizeof(metrics));
+    start_watchdog(COMBOLOCK_WATCHDOG_TIMEOUT_MS);
+}
+
+void start_loop_iteration(void) {
+    iteration_start = get_time_us();
+    checkpoint = iteration_start;
+    memset(subsystem_us, 0, sizeof(subsystem_us));
+}
+
+void end_subsystem(loop_subsystem_t subsystem) {
+    uint64_t now = get_time_us();
+    subsystem_us[subsystem] += (uint32_t) (now - checkpoint);
+    checkpoint = now;
+}
+
+bool end_loop_iteration(void) {
+    uint32_t duration = (uint32_t) (get_time_us() - iteration_start);
+    metrics.iterations++;
+    metrics.last_iteration_us = duration;
+    if (duration <= budget_us) {
+        kick_watchdog();
+        metrics.watchdog_kicks++;
+        return true;
+    }
+    uint8_t culprit = 0;
+    for (uint8_t i = 1; i < NUMBER_OF_SUBSYSTEMS; i++) {
+        if (subsystem_us[i] > subsystem_us[culprit]) {
+            culprit = i;
+        }
+    }
+    metrics.overruns++;
+    metrics.overruns_by_subsystem[culprit]++;
+    if (duration > metrics.worst_iteration_us) {
+        metrics.worst_iteration_us = duration;
+        metrics.worst_subsystem = culprit;
+    }
+    uint32_t duration_ms = duration / 1000;
+    record_flight_event(FLIGHT_DEADLINE, culprit, (uint16_t) ((duration_ms > UINT16_MAX) ? UINT16_MAX : duration_ms));
+    return false;
+}
+
+deadline_metrics_t get_deadline_metrics(void) {
+    return metrics;
+}
+
+char const *get_subsystem_name(loop_subsystem_t subsystem) {
+    return (subsystem < NUMBER_OF_SUBSYSTEMS) ? subsystem_names[subsystem] : "?";
+}
@@ -0,0 +1,105 @@
+/**************************************************************************//**
+ *
+ * @file deadline-monitor.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A monitor that holds each loop() iteration to a time budget, blames
+ *      overruns on the subsystem that used the most of the iteration, and
+ *      kicks the hardware watchdog only after iterations that met the budget.
+ *
+ * A stalled loop never reaches end_loop_iteration(), and a loop that overruns
+ * iteration after iteration never kicks the watchdog either; in both cases
+ * the watchdog resets the RP2040 and the flight recorder keeps the overruns
+ * that led up to it.
+ *
+ * Build with <code>-DCOMBOLOCK_LOOP_BUDGET_US=...</code> or
+ * <code>-DCOMBOLOCK_WATCHDOG_TIMEOUT_MS=...</code> to change the defaults.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_DEADLINE_MONITOR_H
+#define COMBOLOCK_DEADLINE_MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef COMBOLOCK_LOOP_BUDGET_US
+#define COMBOLOCK_LOOP_BUDGET_US        (100000)    // two full display flushes over 400kHz I2C, with room to spare
+#endif
+
+#ifndef COMBOLOCK_WATCHDOG_TIMEOUT_MS
+#define COMBOLOCK_WATCHDOG_TIMEOUT_MS   (2000)
+#endif
+
+typedef enum {
+    SUBSYSTEM_CONTROL_LOCK,
+    SUBSYSTEM_TEST_MODE,
+    SUBSYSTEM_DISPLAY,
+    SUBSYSTEM_TELEMETRY,
+    SUBSYSTEM_DEFERRED_WORK,
+    SUBSYSTEM_HOUSEKEEPING,
+    NUMBER_OF_SUBSYSTEMS
+} loop_subsystem_t;
+
+typedef struct {
+    uint32_t iterations;
+    uint32_t overruns;
+    uint32_t overruns_by_subsystem[NUMBER_OF_SUBSYSTEMS];
+    uint32_t last_iteration_us;
+    uint32_t worst_iteration_us;
+    uint8_t worst_subsystem;
+    uint32_t watchdog_kicks;
+} deadline_metrics_t;
+
+/**
+ * Sets the budget and starts the watchdog. Call at the end of setup().
+ *
+ * @param budget_us The longest a loop() iteration may take
+ */
+void initialize_deadline_monitor(uint32_t budget_us);
+
+/**
+ * Marks the start of a loop() iteration.
+ */
+void start_loop_iteration(void);
+
+/**
+ * Charges the time since the previous checkpoint to `subsystem`.
+ */
+void end_subsystem(loop_subsystem_t subsystem);
+
+/**
+ * Checks the iteration against the budget. An overrun is counted, blamed and
+ * written to the flight recorder; an iteration within budget kicks the
+ * watchdog.
+ *
+ * @return <code>true</code> if the iteration met the budget
+ */
+bool end_loop_iteration(void);
+
+deadline_metrics_t get_deadline_metrics(void);
+
+char const *get_subsystem_name(loop_subsystem_t subsystem);
+
+/**
+ * The hardware watchdog: MBED's on the RP2040, a stand-in on the host.
+ */
+void start_watchdog(uint32_t timeout_ms);
+void kick_watchdog(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_DEADLINE_MONITOR_H
@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ *
+ * @file deferred-work.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code for the prioritized deferred-work queues.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "deferred-work.h"
+#include "pending-work.h"
+#include "time-service.h"
+
+#define SLOT_MASK           (DEFERRED_QUEUE_LENGTH - 1)
+
+#if DEFERRED_QUEUE_LENGTH & SLOT_MASK
+#error "DEFERRED_QUEUE_LENGTH must be a power of two"
+#endif
+
+/* A slot's stamp is the position of its lap's first slot, so that zeroed
+ * memory is a valid empty queue: for the slot at `position`, a stamp of
+ * lap(position) means free, lap(position) + 1 means published. */
+#define LAP(position)       ((position) & ~(uint32_t) SLOT_MASK)
+
+typedef struct {
+    uint32_t volatile stamp;
+    deferred_handler_t handler;
+    uint32_t argument;
+} slot_t;
+
+typedef struct {
+    slot_t slots[DEFERRED_QUEUE_LENGTH];
+    uint32_t volatile head;         // next position to claim
+    uint32_t tail;                  // next position to run; only the main loop moves it
+    uint32_t volatile posted;
+    uint32_t volatile overflows;
+    uint32_t run;
+    uint8_t volatile maximum_depth;
+} deferred_queue_t;
+
+static deferred_queue_t queues[NUMBER_OF_WORK_PRIORITIES];
+
+bool defer_work(work_priority_t priority, deferred_handler_t handler, uint32_t argument) {
+    deferred_queue_t *queue = &queues[priority];
+    uint32_t primask = disable_interrupts();
+    uint32_t position = queue->head;
+    slot_t *slot = &queue->slots[position & SLOT_MASK];
+    if (slot->stamp != LAP(position)) {
+        queue->overflows++;
+        restore_interrupts(primask);
+        return false;
+    }
+    queue->head = position + 1;
+    queue->posted++;
+    uint8_t depth = (uint8_t) (position + 1 - queue->tail);
+    if (depth > queue->maximum_depth) {
+        queue->maximum_depth = depth;
+    }
+    restore_interrupts(primask);
+    slot->handler = handler;
+    slot->argument = argument;
+    slot->stamp = LAP(position) + 1;
+    post_work(WORK_DEFERRED);
+    return true;
+}
+
+/* Takes the oldest published item of the highest priority that has one. */
+static slot_t *next_slot(deferred_queue_t **owner) {
+    for (int priority = 0; priority < NUMBER_OF_WORK_PRIORITIES; priority++) {
+        deferred_queue_t *queue = &queues[priority];
+        slot_t *slot = &queue->slots[queue->tail & SLOT_MASK];
+        if (slot->stamp == LAP(queue->tail) + 1) {
+            *owner = queue;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+unsigned run_deferred_work(uint32_t budget_us) {
+    unsigned count = 0;
+    uint64_t start = get_time_us();
+    deferred_queue_t *queue;
+    slot_t *slot;
+    while ((slot = next_slot(&queue)) != NULL) {
+        deferred_handler_t handler = slot->handler;
+        uint32_t argument = slot->argument;
+        slot->stamp = LAP(queue->tail) + DEFERRED_QUEUE_LENGTH;   // free it for the next lap
+        queue->tail++;
+        queue->run++;
+        handler(argument);
+        count++;
+        if (get_time_us() - start >= budget_us) {
+            break;
+        }
+    }
+    return count;
+}
+
+void get_deferred_work_stats(deferred_queue_stats_t stats[NUMBER_OF_WORK_PRIORITIES]) {
+    for (int priority = 0; priority < NUMBER_OF_WORK_PRIORITIES; priority++) {
+        deferred_queue_t const *queue = &queues[priority];
+        stats[priority].posted = queue->posted;
+        stats[priority].run = queue->run;
+        stats[priority].overflows = queue->overflows;
+        stats[priority].depth = (uint8_t) (queue->head - queue->tail);
+        stats[priority].maximum_depth = queue->maximum_depth;
+    }
+}
@@ -0,0 +1,77 @@
+/**************************************************************************//**
+ *
+ * @file deferred-work.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Work that an ISR hands to the main loop: a fixed-size item (a
+ *      handler and its argument) posted into one of three priority queues and
+ *      run by run_deferred_work() within a time slice, highest priority first.
+ *
+ * Any number of ISRs may post. Each queue is a ring of slots stamped with
+ * the lap they are on: a producer claims a slot by advancing the head (the
+ * only step done with interrupts masked, since the Cortex-M0+ has no exclusive
+ * loads and stores), fills it, and publishes it by stamping it.
+ * The main loop, the only consumer, takes a slot once it is published, so an
+ * ISR preempted between claiming and publishing never exposes a half-written
+ * item, and never blocks a higher-priority ISR from posting.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_DEFERRED_WORK_H
+#define COMBOLOCK_DEFERRED_WORK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEFERRED_QUEUE_LENGTH       (16)        // per priority; must be a power of two
+#define DEFERRED_WORK_SLICE_US      (2000)
+
+typedef enum {
+    WORK_PRIORITY_HIGH, WORK_PRIORITY_NORMAL, WORK_PRIORITY_LOW, NUMBER_OF_WORK_PRIORITIES
+} work_priority_t;
+
+typedef void (*deferred_handler_t)(uint32_t argument);
+
+typedef struct {
+    uint32_t posted;
+    uint32_t run;
+    uint32_t overflows;             // posts refused because the queue was full
+    uint8_t depth;
+    uint8_t maximum_depth;
+} deferred_queue_stats_t;
+
+/**
+ * Queues `handler(argument)` to run in the main loop. Safe to call from ISRs.
+ *
+ * @return <code>true</code> if the item was queued; <code>false</code> if
+ *      the priority's queue was full
+ */
+bool defer_work(work_priority_t priority, deferred_handler_t handler, uint32_t argument);
+
+/**
+ * Runs queued items, highest priority first and in posting order within a
+ * priority, until the queues are empty or `budget_us` has passed. At least
+ * one item runs if any is queued, so a small budget still makes progress.
+ *
+ * @return The number of items run
+ */
+unsigned run_deferred_work(uint32_t budget_us);
+
+void get_deferred_work_stats(deferred_queue_stats_t stats[NUMBER_OF_WORK_PRIORITIES]);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_DEFERRED_WORK_H
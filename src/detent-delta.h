@@ -0,0 +1,41 @@
+/**************************************************************************//**
+ *
+ * @file detent-delta.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The rotary encoder's net detents, taken in one step rather than a
+ *      direction at a time.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_DETENT_DELTA_H
+#define COMBOLOCK_DETENT_DELTA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @return The net detents turned since the last call, positive clockwise,
+ *      read and cleared atomically with respect to the encoder's ISR
+ */
+int take_detent_delta(void);
+
+/**
+ * Adds `detents` to the net detents, as if the dial had been turned; for
+ * replays and tests.
+ */
+void inject_detent_delta(int detents);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_DETENT_DELTA_H
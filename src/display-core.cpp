@@ -0,0 +1,176 @@
+/**************************************************************************//**
+ *
+ * @file display-core.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code for the display mailbox and the second core's render loop.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "display-core.h"
+
+#ifdef COMBOLOCK_DUAL_CORE
+
+#include <atomic>
+
+#ifdef __MBED__
+#include <hardware/i2c.h>
+#include <hardware/sync.h>
+#include <pico/multicore.h>
+
+#define DISPLAY_I2C             (i2c0)      // Wire's bus, already set up by the display's begin()
+#define DISPLAY_ADDRESS         (0x3C)
+#else
+#include <chrono>
+#include <thread>
+#endif //__MBED__
+
+typedef char display_rows_t[8][23];
+
+static display_rows_t mailbox;
+static std::atomic<uint32_t> sequence(0);       // odd while core 0 is writing the mailbox
+static std::atomic<bool> running(false);
+static display_core_metrics_t metrics;          // published is core 0's; the rest are core 1's
+
+static void publish(char const rows[8][23]) {
+    uint32_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(mailbox, rows, sizeof(mailbox));
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+/* Copies the mailbox if it changed since `last_seen`, retrying torn copies. */
+static bool take(display_rows_t copy, uint32_t *last_seen) {
+    while (true) {
+        uint32_t before = sequence.load(std::memory_order_acquire);
+        if (before == *last_seen) {
+            return false;
+        }
+        if (before & 1) {
+            metrics.retries++;
+            continue;
+        }
+        memcpy(copy, mailbox, sizeof(mailbox));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == before) {
+            *last_seen = before;
+            return true;
+        }
+        metrics.retries++;
+    }
+}
+
+#ifdef __MBED__
+/* Wire is an MBED driver, with an RTOS mutex that core 1 cannot take, so core
+ * 1 sends the frame buffer with the SDK's I2C functions instead. */
+static void send_frame(void) {
+    static uint8_t const addressing[] = {0x00, 0x22, 0x00, 0xFF, 0x21, 0x00, 0x7F};
+    static uint8_t transfer[1 + 1024];
+    transfer[0] = 0x40;
+    memcpy(transfer + 1, get_display_framebuffer(), 1024);
+    i2c_write_blocking(DISPLAY_I2C, DISPLAY_ADDRESS, addressing, sizeof(addressing), false);
+    i2c_write_blocking(DISPLAY_I2C, DISPLAY_ADDRESS, transfer, sizeof(transfer), false);
+}
+
+static inline void wait_for_publication(void) {
+    __wfe();
+}
+
+static inline void signal_publication(void) {
+    __sev();
+}
+#else
+static void send_frame(void) {
+    flush_display();
+}
+
+static inline void wait_for_publication(void) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+static inline void signal_publication(void) {}
+#endif //__MBED__
+
+static void display_core_main(void) {
+#ifdef __MBED__
+    multicore_lockout_victim_init();
+#endif
+    static display_rows_t rows;
+    uint32_t last_seen = 0;
+    while (true) {
+        if (take(rows, &last_seen)) {
+            render_display_rows(rows);
+            send_frame();
+            metrics.rendered++;
+        } else {
+            wait_for_publication();
+        }
+    }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void start_display_core(void) {
+    if (running.load()) {
+        return;
+    }
+    running.store(true);
+#ifdef __MBED__
+    multicore_launch_core1(display_core_main);
+#else
+    std::thread(display_core_main).detach();
+#endif
+}
+
+bool offload_display_refresh(char const rows[8][23]) {
+    if (!running.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    // core 0 keeps its own copy, so unchanged screens cost a comparison and no traffic
+    static display_rows_t last_published;
+    if (metrics.published > 0 && !memcmp(last_published, rows, sizeof(last_published))) {
+        return true;
+    }
+    memcpy(last_published, rows, sizeof(last_published));
+    publish(rows);
+    metrics.published++;
+    signal_publication();
+    return true;
+}
+
+void pause_display_core(void) {
+#ifdef __MBED__
+    if (running.load()) {
+        multicore_lockout_start_blocking();
+    }
+#endif
+}
+
+void resume_display_core(void) {
+#ifdef __MBED__
+    if (running.load()) {
+        multicore_lockout_end_blocking();
+    }
+#endif
+}
+
+display_core_metrics_t get_display_core_metrics(void) {
+    return metrics;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_DUAL_CORE
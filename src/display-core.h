@@ -0,0 +1,91 @@
+/**************************************************************************//**
+ *
+ * @file display-core.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The dual-core mode, in which the RP2040's second core renders and
+ *      flushes the display so that the I2C transfer no longer holds up
+ *      loop().
+ *
+ * Built with <code>-DCOMBOLOCK_DUAL_CORE</code>, refresh_display() on core 0
+ * copies the display's rows into a mailbox, if they changed, and returns. Core 1 takes the
+ * newest complete copy, renders it and sends it to the display; copies that
+ * are superseded before core 1 gets to them are skipped. The mailbox is a
+ * sequence lock: core 0 never waits, and core 1 retries any copy that core 0
+ * was midway through writing, so only whole screens are shown. On the host,
+ * a thread stands in for core 1.
+ *
+ * Core 1 runs from flash, so it must be paused while core 0 erases or
+ * programs flash.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_DISPLAY_CORE_H
+#define COMBOLOCK_DISPLAY_CORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t published;         // changed screens handed over by refresh_display()
+    uint32_t rendered;          // screens core 1 rendered and flushed
+    uint32_t retries;           // copies core 1 retried because core 0 was writing
+} display_core_metrics_t;
+
+#ifdef COMBOLOCK_DUAL_CORE
+
+/**
+ * Hands the display to core 1. Call once the display is initialized; from
+ * then on, only core 1 touches the display driver.
+ */
+void start_display_core(void);
+
+/**
+ * @return <code>true</code> if core 1 owns the display and the rows were
+ *      handed to it; <code>false</code> if the caller must refresh the
+ *      display itself
+ */
+bool offload_display_refresh(char const rows[8][23]);
+
+void pause_display_core(void);
+void resume_display_core(void);
+
+display_core_metrics_t get_display_core_metrics(void);
+
+#else
+
+static inline bool offload_display_refresh(char const rows[8][23]) {
+    (void) rows;
+    return false;
+}
+
+static inline void pause_display_core(void) {}
+
+static inline void resume_display_core(void) {}
+
+#endif //COMBOLOCK_DUAL_CORE
+
+/**
+ * The display driver's halves, for whichever core owns it: drawing rows of
+ * text into the frame buffer, and sending the frame buffer to the display.
+ */
+void render_display_rows(char const rows[8][23]);
+void flush_display(void);
+uint8_t *get_display_framebuffer(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_DISPLAY_CORE_H
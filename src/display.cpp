@@ -27,6 +27,7 @@
 #include <CowPi_stdio.h>
 #include <stdlib.h>
 #include "display.h"
+#include "display-core.h"
 
 #if __has_include(<OneBitDisplay.h>)
 #define ONEBIT
@@ -61,9 +62,14 @@ static int character_height;
 static inline void library_specific_initialize_display(int number_of_columns);
 
 static char rows[8][23] = {{0}, {0}, {0}, {0}, {0}, {0}, {0}, {0}};
+static uint32_t refreshes = 0;
 
 #if defined ONEBIT
 
+#ifdef COMBOLOCK_DUAL_CORE
+#error "The dual-core display needs the Adafruit_SSD1306 library's frame buffer."
+#endif
+
 static uint8_t logo[] = {
         0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
         0xff, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x07, 0x07, 0x0f, 0x1f, 0x3f, 0xff, 0xff, 0xff, 0xff, 0xff,
@@ -167,6 +173,7 @@ void draw_logo() {
 }
 
 void refresh_display(void) {
+    refreshes++;
     for (int row = 0; row < row_count; ++row) {
         obdWriteString(&display, 0, 0, character_height * row, (char *) rows[row], font, OBD_BLACK, 0);
     }
@@ -261,20 +268,36 @@ void draw_logo() {
     display.display();
 }
 
-void refresh_display(void) {
+void render_display_rows(char const text[8][23]) {
     display.clearDisplay();
     for (int row = 0; row < row_count; ++row) {
         display.setCursor((int16_t) ((128 - (character_width * column_count)) / 2), (int16_t) (character_height * row));
-        display.print(rows[row]);
+        display.print(text[row]);
     }
+}
+
+void flush_display(void) {
     display.display();
 }
 
+uint8_t *get_display_framebuffer(void) {
+    return display.getBuffer();
+}
+
+void refresh_display(void) {
+    refreshes++;
+    if (offload_display_refresh(rows)) {
+        return;
+    }
+    render_display_rows(rows);
+    flush_display();
+}
+
 
 #endif
 
 
-void initialize_display(int number_of_columns) {
+void configure_display(int number_of_columns) {
     record_build_timestamp(__FILE__, __DATE__, __TIME__);
     if ((number_of_columns != 8) && (number_of_columns != 10) && (number_of_columns != 16) && (number_of_columns != 21)) {
         fprintf(stderr, "number of columns cannot be %d.\n", number_of_columns);
@@ -284,6 +307,10 @@ void initialize_display(int number_of_columns) {
     character_width = (number_of_columns <= 10) ? 12 : 6;
     character_height = (number_of_columns <= 10) ? 16 : 8;
     library_specific_initialize_display(number_of_columns);
+}
+
+void initialize_display(int number_of_columns) {
+    configure_display(number_of_columns);
     clear_display();
 }
 
@@ -444,3 +471,7 @@ void count_visits(int row) {
     sprintf(rows[row] + counter_position, "%02X", ++counters[row]);
     refresh_display();
 }
+
+uint32_t get_display_refreshes(void) {
+    return refreshes;
+}
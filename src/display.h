@@ -30,6 +30,8 @@
 #ifndef COWPI_DISPLAY_H
 #define COWPI_DISPLAY_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -46,6 +48,16 @@ extern "C" {
  */
 void initialize_display(int number_of_columns);
 
+/**
+ * Initializes the SSD1306 display module as initialize_display() does, but
+ * without clearing the screen; the screen keeps whatever it showed until the
+ * next refresh_display().
+ *
+ * @param number_of_columns The number of character columns to be used.
+ *      Valid values are 8, 10, 16, and 21.
+ */
+void configure_display(int number_of_columns);
+
 /**
  * Clears the contents of the SSD1306 display module, giving it a blank screen.
  */
@@ -122,6 +134,11 @@ void print_build_timestamps(bool only_most_recent);
  */
 void count_visits(int row);
 
+/**
+ * @return The number of calls to refresh_display() so far
+ */
+uint32_t get_display_refreshes(void);
+
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -0,0 +1,75 @@
+/**************************************************************************//**
+ *
+ * @file flash-device.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The settings store's view of the RP2040's on-board flash, through
+ *      MBED's FlashIAP driver.
+ *
+ * The settings region is the last SETTINGS_REGION_SIZE bytes of flash, well
+ * past the end of the firmware image.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "display-core.h"
+#include "settings-store.h"
+
+#ifdef __MBED__
+#include <FlashIAP.h>
+
+#define SETTINGS_REGION_SIZE    (16 * 4096)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static mbed::FlashIAP flash_iap;
+static uint32_t region_start;
+static flash_device_t device;
+
+static int read_flash(uint32_t offset, void *buffer, uint32_t length) {
+    return flash_iap.read(buffer, region_start + offset, length);
+}
+
+// core 1 executes from flash, so it is held off while flash is written
+static int program_flash(uint32_t offset, void const *page) {
+    pause_display_core();
+    int result = flash_iap.program(page, region_start + offset, device.page_size);
+    resume_display_core();
+    return result;
+}
+
+static int erase_flash(uint32_t offset) {
+    pause_display_core();
+    int result = flash_iap.erase(region_start + offset, device.sector_size);
+    resume_display_core();
+    return result;
+}
+
+flash_device_t const *get_flash_device(void) {
+    if (device.read == nullptr) {
+        flash_iap.init();
+        region_start = flash_iap.get_flash_start() + flash_iap.get_flash_size() - SETTINGS_REGION_SIZE;
+        device.page_size = flash_iap.get_page_size();
+        device.sector_size = flash_iap.get_sector_size(region_start);
+        device.number_of_sectors = SETTINGS_REGION_SIZE / device.sector_size;
+        device.read = read_flash;
+        device.program = program_flash;
+        device.erase = erase_flash;
+    }
+    return &device;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //__MBED__
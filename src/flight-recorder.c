@@ -0,0 +1,135 @@
+/**************************************************************************//**
+ *
+ * @file flight-recorder.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to keep the reset-surviving event trace.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "flight-recorder.h"
+#include "stack-monitor.h"
+#include "deadline-monitor.h"
+#include "time-service.h"
+
+#define RECORDER_MAGIC      (0xF1178EC0)
+#define SLOT_MASK           (FLIGHT_RECORDER_LENGTH - 1)
+
+#if FLIGHT_RECORDER_LENGTH & SLOT_MASK
+#error "FLIGHT_RECORDER_LENGTH must be a power of two"
+#endif
+
+typedef struct {
+    uint32_t magic;
+    uint32_t capacity;
+    uint32_t generation;
+    uint32_t check;             // guards the three fields above
+    uint32_t next;              // total events ever recorded; the slot is next & SLOT_MASK
+    flight_event_t events[FLIGHT_RECORDER_LENGTH];
+} flight_recorder_t;
+
+static flight_recorder_t recorder __attribute__((section (".uninitialized_ram.")));
+
+static char const *state_names[] = {"LOCKED", "UNLOCKED", "CHANGING", "ALARMED"};
+static char const *overrun_names[] = {"input queue", "keypad queue"};
+
+static uint32_t header_check(void) {
+    return ~(recorder.magic ^ recorder.capacity ^ (recorder.generation * 0x9E3779B9));
+}
+
+static bool header_is_valid(void) {
+    return recorder.magic == RECORDER_MAGIC && recorder.capacity == FLIGHT_RECORDER_LENGTH
+           && recorder.check == header_check();
+}
+
+bool initialize_flight_recorder(void) {
+    bool survived = header_is_valid();
+    if (survived) {
+        dump_flight_recorder();
+        recorder.generation++;
+    } else {
+        memset(&recorder, 0, sizeof(recorder));
+        recorder.magic = RECORDER_MAGIC;
+        recorder.capacity = FLIGHT_RECORDER_LENGTH;
+        recorder.generation = 0;
+    }
+    recorder.check = header_check();
+    record_flight_event(FLIGHT_BOOT, (uint8_t) recorder.generation, 0);
+    return survived;
+}
+
+void record_flight_event(flight_event_type_t type, uint8_t a, uint16_t b) {
+    // claiming a slot must not be interrupted by an ISR that records too
+    uint32_t primask = disable_interrupts();
+    flight_event_t *event = &recorder.events[recorder.next++ & SLOT_MASK];
+    restore_interrupts(primask);
+    event->timestamp_us = (uint32_t) get_time_us();
+    event->type = (uint8_t) type;
+    event->a = a;
+    event->b = b;
+}
+
+int get_flight_events(flight_event_t events[FLIGHT_RECORDER_LENGTH]) {
+    if (!header_is_valid()) {
+        return 0;
+    }
+    uint32_t next = recorder.next;
+    uint32_t count = (next < FLIGHT_RECORDER_LENGTH) ? next : FLIGHT_RECORDER_LENGTH;
+    for (uint32_t i = 0; i < count; i++) {
+        events[i] = recorder.events[(next - count + i) & SLOT_MASK];
+    }
+    return (int) count;
+}
+
+static char const *state_name(uint8_t state) {
+    return (state < 4) ? state_names[state] : "?";
+}
+
+void dump_flight_recorder(void) {
+    static flight_event_t events[FLIGHT_RECORDER_LENGTH];
+    int count = get_flight_events(events);
+    printf("flight recorder: generation %lu, %d of %lu events\n", (unsigned long) recorder.generation, count,
+           (unsigned long) recorder.next);
+    for (int i = 0; i < count; i++) {
+        flight_event_t const *event = &events[i];
+        printf("  %10lu us  ", (unsigned long) event->timestamp_us);
+        switch (event->type) {
+            case FLIGHT_BOOT:
+                printf("boot, generation %d\n", event->a);
+                break;
+            case FLIGHT_STATE:
+                printf("%s -> %s\n", state_name(event->a), state_name((uint8_t) event->b));
+                break;
+            case FLIGHT_ALARM:
+                printf("alarm after %d bad tries\n", event->a);
+                break;
+            case FLIGHT_OVERRUN:
+                printf("%s overrun, %d dropped\n", (event->a < 2) ? overrun_names[event->a] : "?", event->b);
+                break;
+            case FLIGHT_DEADLINE:
+                printf("loop overran its budget: %d ms, mostly %s\n", event->b,
+                       get_subsystem_name((loop_subsystem_t) event->a));
+                break;
+            case FLIGHT_STACK_OVERFLOW:
+                printf("%s stack reached its guard region: %d bytes used\n", get_stack_name((stack_id_t) event->a),
+                       event->b);
+                break;
+            default:
+                printf("unrecognized event %d (%d, %d)\n", event->type, event->a, event->b);
+                break;
+        }
+    }
+}
+
+void discard_flight_recorder(void) {
+    recorder.magic = 0;
+}
@@ -0,0 +1,92 @@
+/**************************************************************************//**
+ *
+ * @file flight-recorder.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A trace of the last FLIGHT_RECORDER_LENGTH noteworthy events, kept
+ *      in RAM that a soft reset, watchdog reset or crash does not clear.
+ *
+ * At startup, initialize_flight_recorder() checks the recorder's header. If
+ * it is valid the recorder survived a reset, and its contents are dumped over
+ * Serial before recording continues; otherwise (after a power cycle) it is
+ * formatted. Recording an event is a handful of stores, and is safe from
+ * ISRs.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_FLIGHT_RECORDER_H
+#define COMBOLOCK_FLIGHT_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLIGHT_RECORDER_LENGTH      (64)        // must be a power of two
+
+typedef enum {
+    FLIGHT_BOOT = 1,            // a: the recorder's generation (boots since formatting)
+    FLIGHT_STATE = 2,           // a: previous lock state, b: new lock state
+    FLIGHT_ALARM = 3,           // a: bad tries
+    FLIGHT_OVERRUN = 4,         // a: overrun_source_t, b: total dropped so far
+    FLIGHT_DEADLINE = 5,        // a: loop_subsystem_t blamed, b: iteration length in ms
+    FLIGHT_STACK_OVERFLOW = 6,  // a: stack_id_t, b: bytes used
+} flight_event_type_t;
+
+typedef enum {
+    OVERRUN_INPUT_QUEUE, OVERRUN_KEYPAD_QUEUE
+} overrun_source_t;
+
+typedef struct {
+    uint32_t timestamp_us;
+    uint8_t type;
+    uint8_t a;
+    uint16_t b;
+} flight_event_t;
+
+/**
+ * Checks whether the recorder survived a reset, dumps it if so, and records
+ * a FLIGHT_BOOT event.
+ *
+ * @return <code>true</code> if the recorder survived a reset;
+ *      <code>false</code> if it had to be formatted
+ */
+bool initialize_flight_recorder(void);
+
+/**
+ * Appends an event, overwriting the oldest once the recorder is full.
+ */
+void record_flight_event(flight_event_type_t type, uint8_t a, uint16_t b);
+
+/**
+ * Copies the recorded events, oldest first.
+ *
+ * @param events Receives up to FLIGHT_RECORDER_LENGTH events
+ * @return The number of events copied
+ */
+int get_flight_events(flight_event_t events[FLIGHT_RECORDER_LENGTH]);
+
+/**
+ * Prints the recorded events over Serial, oldest first.
+ */
+void dump_flight_recorder(void);
+
+/**
+ * Invalidates the header, as a power cycle would.
+ */
+void discard_flight_recorder(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_FLIGHT_RECORDER_H
@@ -0,0 +1,155 @@
+/**************************************************************************//**
+ *
+ * @file input-events.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to debounce the pushbuttons and slide switches and turn their
+ *      changes into events.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "flight-recorder.h"
+#include "deferred-work.h"
+#include "input-events.h"
+#include "input-journal.h"
+#include "interrupt_support.h"
+#include "pending-work.h"
+
+#define INPUT_TIMER         (3)
+#define LONG_PRESS_SAMPLES  (INPUT_LONG_PRESS_MS * 1000 / INPUT_SAMPLE_PERIOD_uS)
+
+static uint8_t integrators[NUMBER_OF_INPUTS];
+static uint16_t held_samples[NUMBER_OF_INPUTS];
+static uint8_t volatile debounced_levels;
+static uint32_t samples;
+
+// single-producer (the ISR), single-consumer (the main loop) queue
+static input_event_t queue[INPUT_QUEUE_LENGTH];
+static uint8_t volatile queue_head = 0;
+static uint8_t volatile queue_tail = 0;
+static uint32_t volatile dropped_events = 0;
+
+static void handle_input_timer_interrupt();
+
+static uint8_t read_levels() {
+    return (cowpi_left_button_is_pressed() << LEFT_BUTTON)
+           | (cowpi_right_button_is_pressed() << RIGHT_BUTTON)
+           | (cowpi_left_switch_is_in_right_position() << LEFT_SWITCH)
+           | (cowpi_right_switch_is_in_right_position() << RIGHT_SWITCH);
+}
+
+static void report_overrun(uint32_t dropped) {
+    printf("input event queue overflowed; %lu events dropped so far\n", (unsigned long) dropped);
+}
+
+static void enqueue(uint8_t input, uint8_t type, uint32_t timestamp_ms) {
+    uint8_t head = queue_head;
+    uint8_t next_head = (head + 1) % INPUT_QUEUE_LENGTH;
+    if (next_head == queue_tail) {
+        dropped_events++;
+        record_flight_event(FLIGHT_OVERRUN, OVERRUN_INPUT_QUEUE, (uint16_t) dropped_events);
+        defer_work(WORK_PRIORITY_LOW, report_overrun, dropped_events);
+        return;
+    }
+    queue[head].input = input;
+    queue[head].type = type;
+    queue[head].timestamp_ms = timestamp_ms;
+    memory_barrier();
+    queue_head = next_head;
+    post_work(WORK_INPUT);
+}
+
+void initialize_input_events() {
+    memset(integrators, 0, sizeof(integrators));
+    memset(held_samples, 0, sizeof(held_samples));
+    samples = 0;
+    queue_head = 0;
+    queue_tail = 0;
+    dropped_events = 0;
+    // start from the current levels so that a switch that is already to the right does not produce an event
+    uint8_t levels = read_levels();
+    for (int i = 0; i < NUMBER_OF_INPUTS; i++) {
+        if (levels & (1 << i)) {
+            integrators[i] = INPUT_DEBOUNCE_SAMPLES;
+            held_samples[i] = LONG_PRESS_SAMPLES;   // too late to call it a long press
+        }
+    }
+    debounced_levels = levels;
+    register_periodic_timer_ISR(INPUT_TIMER, INPUT_SAMPLE_PERIOD_uS, handle_input_timer_interrupt);
+}
+
+bool get_input_event(input_event_t *event) {
+    uint8_t tail = queue_tail;
+    if (tail == queue_head) {
+        return false;
+    }
+    memory_barrier();
+    *event = queue[tail];
+    memory_barrier();           // done with the slot before the ISR may reuse it
+    queue_tail = (tail + 1) % INPUT_QUEUE_LENGTH;
+    journal_input_event(event);
+    return true;
+}
+
+void inject_input_event(input_event_t const *event) {
+    uint8_t mask = 1 << event->input;
+    if (event->type == INPUT_PRESSED) {
+        debounced_levels |= mask;
+    } else if (event->type == INPUT_RELEASED) {
+        debounced_levels &= ~mask;
+    }
+    enqueue(event->input, event->type, event->timestamp_ms);
+}
+
+void restore_input_levels(uint8_t levels) {
+    debounced_levels = levels;
+}
+
+bool input_is_pressed(input_t input) {
+    return debounced_levels & (1 << input);
+}
+
+uint32_t get_dropped_input_events() {
+    return dropped_events;
+}
+
+void sample_inputs(uint8_t levels) {
+    uint8_t debounced = debounced_levels;
+    uint32_t now = ++samples * (INPUT_SAMPLE_PERIOD_uS / 1000);
+    for (int i = 0; i < NUMBER_OF_INPUTS; i++) {
+        uint8_t mask = 1 << i;
+        if (levels & mask) {
+            if (integrators[i] < INPUT_DEBOUNCE_SAMPLES) {
+                integrators[i]++;
+            }
+        } else if (integrators[i] > 0) {
+            integrators[i]--;
+        }
+        if (!(debounced & mask) && integrators[i] == INPUT_DEBOUNCE_SAMPLES) {
+            debounced |= mask;
+            held_samples[i] = 0;
+            enqueue(i, INPUT_PRESSED, now);
+        } else if ((debounced & mask) && integrators[i] == 0) {
+            debounced &= ~mask;
+            enqueue(i, INPUT_RELEASED, now);
+        } else if ((debounced & mask) && held_samples[i] < LONG_PRESS_SAMPLES) {
+            if (++held_samples[i] == LONG_PRESS_SAMPLES) {
+                enqueue(i, INPUT_LONG_PRESSED, now);
+            }
+        }
+    }
+    debounced_levels = debounced;
+}
+
+static void handle_input_timer_interrupt() {
+    sample_inputs(read_levels());
+}
@@ -0,0 +1,100 @@
+/**************************************************************************//**
+ *
+ * @file input-events.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Debounced, edge-detected events for the pushbuttons and slide
+ *      switches, sampled from a periodic timer.
+ *
+ * A button is "pressed" while it is held down. A switch is "pressed" while it
+ * is in its right position, so moving a switch to the right produces
+ * INPUT_PRESSED and moving it back produces INPUT_RELEASED.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_INPUT_EVENTS_H
+#define COMBOLOCK_INPUT_EVENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INPUT_SAMPLE_PERIOD_uS  (2000)
+#define INPUT_DEBOUNCE_SAMPLES  (5)
+#define INPUT_LONG_PRESS_MS     (1000)
+#define INPUT_QUEUE_LENGTH      (16)
+
+typedef enum {
+    LEFT_BUTTON, RIGHT_BUTTON, LEFT_SWITCH, RIGHT_SWITCH, NUMBER_OF_INPUTS
+} input_t;
+
+typedef enum {
+    INPUT_PRESSED, INPUT_RELEASED, INPUT_LONG_PRESSED
+} input_event_type_t;
+
+typedef struct {
+    uint8_t input;
+    uint8_t type;
+    uint32_t timestamp_ms;      // sample time, in milliseconds since initialization
+} input_event_t;
+
+/**
+ * Registers the timer ISR that samples the buttons and switches.
+ */
+void initialize_input_events();
+
+/**
+ * Removes the oldest event from the queue. Only one context may consume.
+ *
+ * @param event Receives the event
+ * @return <code>true</code> if there was an event; <code>false</code> otherwise
+ */
+bool get_input_event(input_event_t *event);
+
+/**
+ * @return <code>true</code> if the debounced input is pressed (or, for a
+ *      switch, in its right position); <code>false</code> otherwise
+ */
+bool input_is_pressed(input_t input);
+
+/**
+ * @return The number of events lost because the queue was full
+ */
+uint32_t get_dropped_input_events();
+
+/**
+ * Queues an event as though the timer had detected it, and updates the
+ * debounced levels to match. Used to replay a journal.
+ */
+void inject_input_event(input_event_t const *event);
+
+/**
+ * Overwrites the debounced levels. Used to replay a journal.
+ *
+ * @param levels Bit <i>n</i> is set if input <i>n</i> is pressed
+ */
+void restore_input_levels(uint8_t levels);
+
+/**
+ * Processes one sample of every input. The timer ISR calls this with the
+ * hardware levels; a host can call it directly with simulated samples.
+ *
+ * @param levels Bit <i>n</i> is set if input <i>n</i> is pressed
+ */
+void sample_inputs(uint8_t levels);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_INPUT_EVENTS_H
@@ -0,0 +1,143 @@
+/**************************************************************************//**
+ *
+ * @file input-journal.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to record the lock controller's inputs and outputs.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "combination-engine.h"
+#include "deferred-work.h"
+#include "input-journal.h"
+#include "time-service.h"
+
+static uint8_t journal[JOURNAL_CAPACITY];
+static size_t journal_length = 0;
+static bool recording = false;
+static bool overflowed = false;
+static uint32_t last_record_ms;
+static bool step_has_records;
+static uint8_t last_output = 0;
+
+static void write_record(uint8_t type, uint8_t value, uint16_t gap_ms) {
+    if (journal_length + JOURNAL_RECORD_SIZE > JOURNAL_CAPACITY) {
+        overflowed = true;
+        recording = false;
+        return;
+    }
+    journal[journal_length++] = type;
+    journal[journal_length++] = value;
+    journal[journal_length++] = (uint8_t) (gap_ms & 0xFF);
+    journal[journal_length++] = (uint8_t) (gap_ms >> 8);
+}
+
+static void append(uint8_t type, uint8_t value) {
+    uint32_t now = get_time_ms();
+    uint32_t gap = now - last_record_ms;
+    last_record_ms = now;
+    while (gap > UINT16_MAX) {
+        write_record(JOURNAL_TIME, 0, UINT16_MAX);
+        gap -= UINT16_MAX;
+    }
+    write_record(type, value, (uint16_t) gap);
+}
+
+void start_input_journal(uint8_t const combination[], uint8_t bad_tries) {
+    memset(journal, 0, JOURNAL_HEADER_SIZE);
+    memcpy(journal, JOURNAL_MAGIC, 3);
+    journal[3] = JOURNAL_VERSION;
+    journal[4] = COMBOLOCK_DIAL_POSITIONS;
+    journal[5] = COMBINATION_LENGTH;
+    journal[6] = (input_is_pressed(LEFT_BUTTON) << LEFT_BUTTON)
+                 | (input_is_pressed(RIGHT_BUTTON) << RIGHT_BUTTON)
+                 | (input_is_pressed(LEFT_SWITCH) << LEFT_SWITCH)
+                 | (input_is_pressed(RIGHT_SWITCH) << RIGHT_SWITCH);
+    journal[7] = bad_tries;
+    memcpy(journal + 8, combination, COMBINATION_LENGTH);
+    journal_length = JOURNAL_HEADER_SIZE;
+    overflowed = false;
+    step_has_records = false;
+    last_record_ms = get_time_ms();
+    recording = true;
+}
+
+void stop_input_journal() {
+    recording = false;
+}
+
+void journal_detent_delta(int detents) {
+    if (!recording || detents == 0) {
+        return;
+    }
+    while (detents != 0) {
+        int8_t part = (int8_t) ((detents > INT8_MAX) ? INT8_MAX : (detents < -INT8_MAX) ? -INT8_MAX : detents);
+        append(JOURNAL_DETENTS, (uint8_t) part);
+        detents -= part;
+    }
+    step_has_records = true;
+}
+
+void journal_input_event(input_event_t const *event) {
+    if (recording) {
+        append(JOURNAL_INPUT, (uint8_t) (event->input << 4 | event->type));
+        step_has_records = true;
+    }
+}
+
+void journal_keypad_event(keypad_event_t const *event) {
+    if (recording) {
+        append(JOURNAL_KEY, (uint8_t) ((event->key & 0x7F) | (event->pressed ? 0x80 : 0)));
+        step_has_records = true;
+    }
+}
+
+void journal_step(uint8_t output) {
+    if (recording && (step_has_records || output != last_output)) {
+        append(JOURNAL_STEP, output);
+    }
+    step_has_records = false;
+    last_output = output;
+}
+
+uint8_t get_journal_output() {
+    return last_output;
+}
+
+uint8_t const *get_input_journal(size_t *length) {
+    *length = journal_length;
+    return journal;
+}
+
+bool input_journal_overflowed() {
+    return overflowed;
+}
+
+#define DUMP_LINE_LENGTH        (32)
+
+/* Prints one line of the dump and queues the next, so that the loop runs
+ * between lines. */
+static void dump_journal_line(uint32_t offset) {
+    size_t end = (offset + DUMP_LINE_LENGTH < journal_length) ? offset + DUMP_LINE_LENGTH : journal_length;
+    for (size_t i = offset; i < end; i++) {
+        printf("%02x", journal[i]);
+    }
+    printf("\n");
+    if (end < journal_length && !defer_work(WORK_PRIORITY_LOW, dump_journal_line, (uint32_t) end)) {
+        printf("journal dump cut short at byte %lu\n", (unsigned long) end);
+    }
+}
+
+void dump_input_journal() {
+    if (journal_length > 0) {
+        defer_work(WORK_PRIORITY_LOW, dump_journal_line, 0);
+    }
+}
@@ -0,0 +1,118 @@
+/**************************************************************************//**
+ *
+ * @file input-journal.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A compact binary journal of everything the lock controller reads,
+ *      so that a unit's session can be replayed off-device.
+ *
+ * The journal starts with a 16-byte header recording the dial geometry, the
+ * debounced input levels, the bad-try count and the combination. Each record
+ * after that is four bytes: a type, a value, and the milliseconds since the
+ * previous record (little-endian). A JOURNAL_STEP record closes every
+ * control_lock() iteration that consumed input or changed the controller's
+ * output, and carries that output so a replay can detect divergence.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_INPUT_JOURNAL_H
+#define COMBOLOCK_INPUT_JOURNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "input-events.h"
+#include "keypad.h"
+#include "rotary-encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define JOURNAL_CAPACITY        (16384)
+#define JOURNAL_HEADER_SIZE     (16)
+#define JOURNAL_RECORD_SIZE     (4)
+#define JOURNAL_MAGIC           "CLJ"
+#define JOURNAL_VERSION         (2)
+
+typedef enum {
+    JOURNAL_DIRECTION = 1,      // value: direction_t; version 1 journals only
+    JOURNAL_INPUT = 2,          // value: input << 4 | input_event_type_t
+    JOURNAL_KEY = 3,            // value: key, with bit 7 set for a press
+    JOURNAL_STEP = 4,           // value: output, see JOURNAL_OUTPUT()
+    JOURNAL_TIME = 5,           // no value; only extends the time gap
+    JOURNAL_DETENTS = 6,        // value: net detents as int8_t, positive clockwise
+} journal_record_type_t;
+
+/** The controller's output as recorded in a JOURNAL_STEP record. */
+#define JOURNAL_OUTPUT(state, bad_tries)    ((uint8_t) (((bad_tries) > 63 ? 63 : (bad_tries)) << 2 | ((state) & 0x3)))
+
+/**
+ * Discards any previous journal and starts recording a new one.
+ *
+ * @param combination The combination in effect, COMBINATION_LENGTH numbers
+ * @param bad_tries The bad-try count in effect
+ */
+void start_input_journal(uint8_t const combination[], uint8_t bad_tries);
+
+/**
+ * Stops recording. The journal's contents are kept.
+ */
+void stop_input_journal();
+
+/**
+ * Append a record of an input that the lock controller consumed. These are
+ * called from take_detent_delta(), get_input_event() and get_keypad_event(),
+ * and do nothing unless the journal is recording. A delta too large for one
+ * record is split across several.
+ */
+void journal_detent_delta(int detents);
+void journal_input_event(input_event_t const *event);
+void journal_keypad_event(keypad_event_t const *event);
+
+/**
+ * Marks the end of a control_lock() iteration. Writes a JOURNAL_STEP record if
+ * anything was journaled during the iteration or the output changed.
+ *
+ * @param output The controller's output, from JOURNAL_OUTPUT()
+ */
+void journal_step(uint8_t output);
+
+/**
+ * @return The output passed to the most recent journal_step(), whether or not
+ *      the journal is recording
+ */
+uint8_t get_journal_output();
+
+/**
+ * @param length Receives the number of bytes in the journal
+ * @return The journal's bytes
+ */
+uint8_t const *get_input_journal(size_t *length);
+
+/**
+ * @return <code>true</code> if records were lost because the journal was full
+ */
+bool input_journal_overflowed();
+
+/**
+ * Prints the journal as hexadecimal, 32 bytes per line, which
+ * <code>xxd -r -p</code> turns back into the binary journal. Each line is a
+ * low-priority deferred work item, so this returns at once and the dump
+ * never holds up the loop for longer than one line; records added while it
+ * prints are included.
+ */
+void dump_input_journal();
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_INPUT_JOURNAL_H
@@ -224,6 +224,7 @@ void reset_timer(unsigned int timer_number) {
 #ifdef __MBED__
 #include <InterruptIn.h>
 #include <Ticker.h>
+#include <Timeout.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -309,6 +310,21 @@ void reset_periodic_timer(unsigned int timer_number) {
     timers[timer_number].ticker->attach(timers[timer_number].interrupt_service_routine, timers[timer_number].period);
 }
 
+static mbed::Timeout *timeouts[MAXIMUM_NUMBER_OF_TIMERS] = {
+        nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+bool register_one_shot_timer_ISR(unsigned int timer_number, uint32_t delay_us, void (*isr)(void)) {
+    if (timer_number >= MAXIMUM_NUMBER_OF_TIMERS) {
+        return false;
+    }
+    if (timeouts[timer_number] == nullptr) {
+        timeouts[timer_number] = new mbed::Timeout();
+    }
+    timeouts[timer_number]->attach(isr, std::chrono::microseconds(delay_us));
+    return true;
+}
+
 #ifdef __cplusplus
 }
 // extern "C"
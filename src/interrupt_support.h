@@ -108,7 +108,7 @@ bool register_timer_ISR(unsigned int timer_number, unsigned int isr_slot, void (
 
 #endif //__AVR__
 
-#ifdef __MBED__
+#if defined (__MBED__) || defined (COMBOLOCK_HOST)
 
 //static unsigned int constexpr MAXIMUM_NUMBER_OF_TICKERS = 8;
 #define MAXIMUM_NUMBER_OF_TIMERS (8)     // gotta maintain portability with pre-C23 for now
@@ -131,7 +131,23 @@ bool register_timer_ISR(unsigned int timer_number, unsigned int isr_slot, void (
  */
 bool register_periodic_timer_ISR(unsigned int timer_number, uint32_t period_us, void (*isr)(void));
 
-#endif //__MBED__
+/**
+ * @brief Configures a timer interrupt to fire once, and assigns a function to
+ * service that interrupt.
+ *
+ * The one-shot timers are numbered separately from the periodic timers, and
+ * there are up to `MAXIMUM_NUMBER_OF_TIMERS` of them. Arming a timer that is
+ * already armed replaces its delay and its ISR.
+ *
+ * @param timer_number A unique handle for the virtual timer being configured
+ * @param delay_us How long from now the interrupt fires
+ * @param isr The function that will service the timer's interrupt
+ * @return <code>true</code> if the interrupt was successfully scheduled and
+ *      the ISR was successfully registered; <code>false</code> otherwise
+ */
+bool register_one_shot_timer_ISR(unsigned int timer_number, uint32_t delay_us, void (*isr)(void));
+
+#endif //__MBED__ || COMBOLOCK_HOST
 
 #ifdef __cplusplus
 } // extern "C"
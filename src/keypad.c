@@ -0,0 +1,151 @@
+/**************************************************************************//**
+ *
+ * @file keypad.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to scan and debounce the keypad from a periodic timer.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "deferred-work.h"
+#include "flight-recorder.h"
+#include "interrupt_support.h"
+#include "input-journal.h"
+#include "keypad.h"
+#include "pending-work.h"
+
+#define KEYPAD_TIMER        (2)
+#define NUMBER_OF_KEYS      (16)
+
+static char const keys[NUMBER_OF_KEYS] = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', '*', '#'
+};
+
+/* Each key has an integrator that counts toward KEYPAD_DEBOUNCE_SCANS while the
+ * key is sampled down and toward 0 while it is sampled up; the debounced state
+ * only changes when the integrator reaches either end. */
+static uint8_t integrators[NUMBER_OF_KEYS];
+static uint16_t debounced_keys;
+
+// single-producer (the ISR), single-consumer (the main loop) queue
+static keypad_event_t queue[KEYPAD_QUEUE_LENGTH];
+static uint8_t volatile queue_head = 0;
+static uint8_t volatile queue_tail = 0;
+
+static keypad_metrics_t volatile metrics;
+
+static void handle_keypad_timer_interrupt();
+
+static int key_index(char key) {
+    for (int i = 0; i < NUMBER_OF_KEYS; i++) {
+        if (keys[i] == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void report_overrun(uint32_t dropped) {
+    printf("keypad event queue overflowed; %lu events dropped so far\n", (unsigned long) dropped);
+}
+
+static void enqueue(char key, bool pressed) {
+    uint8_t head = queue_head;
+    uint8_t next_head = (head + 1) % KEYPAD_QUEUE_LENGTH;
+    if (next_head == queue_tail) {
+        metrics.dropped_events++;
+        record_flight_event(FLIGHT_OVERRUN, OVERRUN_KEYPAD_QUEUE, (uint16_t) metrics.dropped_events);
+        defer_work(WORK_PRIORITY_LOW, report_overrun, metrics.dropped_events);
+        return;
+    }
+    queue[head].key = key;
+    queue[head].pressed = pressed;
+    queue[head].timestamp_ms = metrics.scans * (KEYPAD_SCAN_PERIOD_uS / 1000);
+    memory_barrier();
+    queue_head = next_head;
+    post_work(WORK_KEYPAD);
+    metrics.events++;
+    uint8_t depth = (next_head + KEYPAD_QUEUE_LENGTH - queue_tail) % KEYPAD_QUEUE_LENGTH;
+    if (depth > metrics.maximum_queue_depth) {
+        metrics.maximum_queue_depth = depth;
+    }
+}
+
+void initialize_keypad() {
+    memset(integrators, 0, sizeof(integrators));
+    debounced_keys = 0;
+    queue_head = 0;
+    queue_tail = 0;
+    memset((void *) &metrics, 0, sizeof(metrics));
+    register_periodic_timer_ISR(KEYPAD_TIMER, KEYPAD_SCAN_PERIOD_uS, handle_keypad_timer_interrupt);
+}
+
+bool get_keypad_event(keypad_event_t *event) {
+    uint8_t tail = queue_tail;
+    if (tail == queue_head) {
+        return false;
+    }
+    memory_barrier();
+    *event = queue[tail];
+    memory_barrier();           // done with the slot before the ISR may reuse it
+    queue_tail = (tail + 1) % KEYPAD_QUEUE_LENGTH;
+    journal_keypad_event(event);
+    return true;
+}
+
+void inject_keypad_event(keypad_event_t const *event) {
+    uint8_t head = queue_head;
+    uint8_t next_head = (head + 1) % KEYPAD_QUEUE_LENGTH;
+    if (next_head == queue_tail) {
+        metrics.dropped_events++;
+        return;
+    }
+    queue[head] = *event;
+    memory_barrier();
+    queue_head = next_head;
+}
+
+void get_keypad_metrics(keypad_metrics_t *copy) {
+    memcpy(copy, (void const *) &metrics, sizeof(*copy));
+}
+
+void scan_keypad(char sample) {
+    int down = key_index(sample);
+    metrics.scans++;
+    for (int i = 0; i < NUMBER_OF_KEYS; i++) {
+        bool is_debounced_down = debounced_keys & (1 << i);
+        if (i == down) {
+            if (integrators[i] < KEYPAD_DEBOUNCE_SCANS) {
+                integrators[i]++;
+                if (is_debounced_down && integrators[i] == KEYPAD_DEBOUNCE_SCANS) {
+                    metrics.rejected_bounces++;     // dipped, but came back before releasing
+                }
+            }
+        } else if (integrators[i] > 0) {
+            integrators[i]--;
+            if (!is_debounced_down && integrators[i] == 0) {
+                metrics.rejected_bounces++;         // rose, but fell back before pressing
+            }
+        }
+        if (!is_debounced_down && integrators[i] == KEYPAD_DEBOUNCE_SCANS) {
+            debounced_keys |= 1 << i;
+            enqueue(keys[i], true);
+        } else if (is_debounced_down && integrators[i] == 0) {
+            debounced_keys &= ~(1 << i);
+            enqueue(keys[i], false);
+        }
+    }
+}
+
+static void handle_keypad_timer_interrupt() {
+    scan_keypad(cowpi_get_keypress());
+}
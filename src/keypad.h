@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ *
+ * @file keypad.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A keypad driver that scans the matrix from a periodic timer,
+ *      debounces each key, and queues press and release events.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_KEYPAD_H
+#define COMBOLOCK_KEYPAD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KEYPAD_SCAN_PERIOD_uS   (2000)
+#define KEYPAD_DEBOUNCE_SCANS   (5)
+#define KEYPAD_QUEUE_LENGTH     (16)
+
+typedef struct {
+    char key;
+    bool pressed;
+    uint32_t timestamp_ms;      // scan time, in milliseconds since initialization
+} keypad_event_t;
+
+typedef struct {
+    uint32_t scans;
+    uint32_t events;
+    uint32_t dropped_events;    // events lost because the queue was full
+    uint32_t rejected_bounces;  // level changes that did not outlast the debounce window
+    uint8_t maximum_queue_depth;
+} keypad_metrics_t;
+
+/**
+ * Registers the timer ISR that scans the keypad.
+ */
+void initialize_keypad();
+
+/**
+ * Removes the oldest event from the queue. Only one context may consume.
+ *
+ * @param event Receives the event
+ * @return <code>true</code> if there was an event; <code>false</code> otherwise
+ */
+bool get_keypad_event(keypad_event_t *event);
+
+/**
+ * Copies the driver's counters.
+ */
+void get_keypad_metrics(keypad_metrics_t *metrics);
+
+/**
+ * Queues an event as though the scanner had detected it. Used to replay a
+ * journal.
+ */
+void inject_keypad_event(keypad_event_t const *event);
+
+/**
+ * Processes one scan of the keypad. The timer ISR calls this with the result
+ * of <code>cowpi_get_keypress()</code>; a host can call it directly with
+ * simulated samples.
+ *
+ * @param sample The key that is down during this scan, or 0 if none is
+ */
+void scan_keypad(char sample);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_KEYPAD_H
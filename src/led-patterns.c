@@ -0,0 +1,141 @@
+/**************************************************************************//**
+ *
+ * @file led-patterns.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to play LED patterns from a periodic timer.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "interrupt_support.h"
+#include "pending-work.h"
+#include "led-patterns.h"
+
+#define LED_TIMER           (1)
+
+static led_step_t const blink_steps[] = {
+        {.leds = BOTH_LEDS, .duration_ms = 250},
+        {.leds = LEDS_OFF, .duration_ms = 250},
+};
+
+static led_step_t const pulse_steps[] = {
+        {.leds = BOTH_LEDS, .duration_ms = 50},
+        {.leds = LEDS_OFF, .duration_ms = 950},
+};
+
+static led_step_t const sequence_steps[] = {
+        {.leds = LEFT_LED, .duration_ms = 200},
+        {.leds = RIGHT_LED, .duration_ms = 200},
+        {.leds = BOTH_LEDS, .duration_ms = 200},
+        {.leds = LEDS_OFF, .duration_ms = 200},
+};
+
+led_pattern_t const BAD_TRY_PATTERN = {.steps = blink_steps, .number_of_steps = 2, .repetitions = 2};
+led_pattern_t const ALARM_PATTERN = {.steps = blink_steps, .number_of_steps = 2, .repetitions = 0};
+led_pattern_t const PULSE_PATTERN = {.steps = pulse_steps, .number_of_steps = 2, .repetitions = 0};
+led_pattern_t const SEQUENCE_PATTERN = {.steps = sequence_steps, .number_of_steps = 4, .repetitions = 0};
+
+// written by the main context, consumed by the ISR
+static led_pattern_t const *volatile requested_pattern = NULL;
+static bool volatile restart_requested = false;
+
+// owned by the ISR
+static led_pattern_t const *volatile active_pattern = NULL;
+static uint8_t step_index;
+static uint8_t repetitions_completed;
+static uint32_t remaining_ms;
+
+static void handle_led_timer_interrupt();
+
+static void show(uint8_t leds) {
+    if (leds & LEFT_LED) {
+        cowpi_illuminate_left_led();
+    } else {
+        cowpi_deluminate_left_led();
+    }
+    if (leds & RIGHT_LED) {
+        cowpi_illuminate_right_led();
+    } else {
+        cowpi_deluminate_right_led();
+    }
+}
+
+static void enter_step(uint8_t index) {
+    step_index = index;
+    remaining_ms = active_pattern->steps[index].duration_ms;
+    show(active_pattern->steps[index].leds);
+}
+
+void initialize_led_patterns() {
+    requested_pattern = NULL;
+    restart_requested = false;
+    active_pattern = NULL;
+    register_periodic_timer_ISR(LED_TIMER, LED_TICK_MS * 1000, handle_led_timer_interrupt);
+}
+
+bool start_led_pattern(led_pattern_t const *pattern) {
+    if (pattern != NULL) {
+        for (int i = 0; i < pattern->number_of_steps; i++) {
+            if (pattern->steps[i].duration_ms == 0) {
+                return false;
+            }
+        }
+    }
+    requested_pattern = pattern;
+    restart_requested = true;
+    return true;
+}
+
+void stop_led_pattern() {
+    start_led_pattern(NULL);
+}
+
+bool led_pattern_is_active() {
+    return restart_requested || active_pattern != NULL;
+}
+
+void advance_led_pattern(uint32_t elapsed_ms) {
+    if (restart_requested) {
+        restart_requested = false;
+        active_pattern = requested_pattern;
+        repetitions_completed = 0;
+        if (active_pattern == NULL || active_pattern->number_of_steps == 0) {
+            active_pattern = NULL;
+            show(LEDS_OFF);
+        } else {
+            enter_step(0);
+        }
+        return;
+    }
+    if (active_pattern == NULL) {
+        return;
+    }
+    while (elapsed_ms >= remaining_ms) {
+        elapsed_ms -= remaining_ms;
+        uint8_t next_step = step_index + 1;
+        if (next_step == active_pattern->number_of_steps) {
+            next_step = 0;
+            repetitions_completed++;
+            if (active_pattern->repetitions && repetitions_completed == active_pattern->repetitions) {
+                active_pattern = NULL;
+                show(LEDS_OFF);
+                post_work(WORK_LEDS);
+                return;
+            }
+        }
+        enter_step(next_step);
+    }
+    remaining_ms -= elapsed_ms;
+}
+
+static void handle_led_timer_interrupt() {
+    advance_led_pattern(LED_TICK_MS);
+}
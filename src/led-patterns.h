@@ -0,0 +1,106 @@
+/**************************************************************************//**
+ *
+ * @file led-patterns.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Table-driven LED patterns that are advanced by a periodic timer so
+ *      that starting a pattern never blocks the main loop.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_LED_PATTERNS_H
+#define COMBOLOCK_LED_PATTERNS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LED_TICK_MS         (10)
+
+typedef enum {
+    LEDS_OFF = 0, LEFT_LED = 1, RIGHT_LED = 2, BOTH_LEDS = LEFT_LED | RIGHT_LED
+} led_mask_t;
+
+/**
+ * One entry of a pattern table: which LEDs are lit and for how long.
+ * The LEDs only change on an LED_TICK_MS tick. Each step's leftover time
+ * carries into the next step, so a step is not rounded up on its own. A
+ * step can show for one tick more or less than its duration, but the
+ * pattern as a whole keeps to the sum of its durations. A step shorter than
+ * a tick may not show at all.
+ */
+typedef struct {
+    uint8_t leds;
+    uint16_t duration_ms;
+} led_step_t;
+
+/**
+ * A pattern is a table of steps that is played `repetitions` times, or
+ * indefinitely if `repetitions` is 0.
+ */
+typedef struct {
+    led_step_t const *steps;
+    uint8_t number_of_steps;
+    uint8_t repetitions;
+} led_pattern_t;
+
+/** Both LEDs on for 250ms, off for 250ms, twice. Signals a bad try. */
+extern led_pattern_t const BAD_TRY_PATTERN;
+/** Both LEDs on for 250ms, off for 250ms, until stopped. */
+extern led_pattern_t const ALARM_PATTERN;
+/** A brief flash followed by a long pause, until stopped. */
+extern led_pattern_t const PULSE_PATTERN;
+/** Left, right, both, neither, until stopped. */
+extern led_pattern_t const SEQUENCE_PATTERN;
+
+/**
+ * Registers the timer ISR that advances the active pattern.
+ */
+void initialize_led_patterns();
+
+/**
+ * Requests that `pattern` replace whatever pattern is playing. Returns
+ * immediately; the pattern starts on the next LED tick. A pattern with a
+ * step of zero duration would never leave that step, and is refused.
+ *
+ * @param pattern The pattern to play, or NULL to stop the current pattern
+ * @return <code>false</code> if the pattern was refused, leaving the current
+ *      pattern playing; <code>true</code> otherwise
+ */
+bool start_led_pattern(led_pattern_t const *pattern);
+
+/**
+ * Stops the active pattern and turns both LEDs off on the next LED tick.
+ */
+void stop_led_pattern();
+
+/**
+ * @return <code>true</code> if a pattern is playing or about to start;
+ *      <code>false</code> otherwise
+ */
+bool led_pattern_is_active();
+
+/**
+ * Advances the active pattern by `elapsed_ms` milliseconds. The timer ISR
+ * calls this with LED_TICK_MS; a host can call it directly to drive the
+ * pattern engine from a virtual clock.
+ *
+ * @param elapsed_ms The time since the previous call
+ */
+void advance_led_pattern(uint32_t elapsed_ms);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_LED_PATTERNS_H
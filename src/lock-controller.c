@@ -5,7 +5,8 @@
  * @author (STUDENTS -- Nolan Hill)
  * @author (STUDENTS -- Nick Goertzen)
  *
- * @brief Code to implement the "combination lock" mode.
+ * @brief Code to implement the "combination lock" mode on the CowPi: the one
+ *      lock instance, with its callbacks wired to the hardware and services.
  *
  ******************************************************************************/
 
@@ -15,274 +16,168 @@
  */
 
  #include <CowPi.h>
+ #include "combination-engine.h"
+ #include "detent-delta.h"
  #include "display.h"
+ #include "flight-recorder.h"
+ #include "input-events.h"
+ #include "input-journal.h"
+ #include "keypad.h"
+ #include "led-patterns.h"
  #include "lock-controller.h"
+ #include "lock-instance.h"
+ #include "lock-status.h"
  #include "rotary-encoder.h"
  #include "servomotor.h"
+ #include "settings-store.h"
+ #include "telemetry.h"
  
  
-typedef enum {
-    LOCKED, UNLOCKED, CHANGING, ALARMED
-} lock_state_t;
+/* The combination is also kept in RAM that survives a reset, for when the
+ * settings store has none. */
+static uint8_t combination[COMBINATION_LENGTH] __attribute__((section (".uninitialized_ram.")));
+static lock_instance_t lock;
 
-static lock_state_t state = LOCKED;
-static direction_t correct_direction;
-static uint8_t combination[3] __attribute__((section (".uninitialized_ram.")));
-static int bad_tries = 0;
-static uint8_t entered_combination[3];
-static int visible_counts[3] = {0, 0, 0};
-static uint8_t current_number = 0;
-static int entry_stage = 0;
-static bool handle_keypress = false;
-static cowpi_timer_t volatile *timer;
-int digit_index = 0;
-uint8_t new_combination[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-key_t handle_key;
+static int take_detents(void *context) {
+    return take_detent_delta();
+}
 
-uint8_t const *get_combination() {
-return combination;
+static bool take_input_event(void *context, input_event_t *event) {
+    return get_input_event(event);
 }
- 
-void force_combination_reset() {
-    combination[0] = 5;
-    combination[1] = 10;
-    combination[2] = 15;
+
+static bool take_keypad_event(void *context, keypad_event_t *event) {
+    return get_keypad_event(event);
 }
- 
-bool check_combination(void) {
-    return entered_combination[0] == combination[0]
-        && entered_combination[1] == combination[1]
-        && entered_combination[2] == combination[2]
-        && visible_counts[0] >= 3
-        && visible_counts[1] == 2
-        && visible_counts[2] == 1;
+
+static bool read_input(void *context, input_t input) {
+    return input_is_pressed(input);
 }
 
-uint32_t get_microseconds(void) {
-    return timer->raw_lower_word;
+static bool pattern_is_active(void *context) {
+    return led_pattern_is_active();
 }
- 
-void blink_leds(){
-    for (int i = 0; i < 2; i++) {
+
+static void set_leds(void *context, bool left, bool right) {
+    if (left) {
         cowpi_illuminate_left_led();
-        cowpi_illuminate_right_led();
-        uint32_t start_time = get_microseconds();
-        while ((get_microseconds() - start_time) < 250000) {}
+    } else {
         cowpi_deluminate_left_led();
+    }
+    if (right) {
+        cowpi_illuminate_right_led();
+    } else {
         cowpi_deluminate_right_led();
-        start_time = get_microseconds();
-        while ((get_microseconds() - start_time) < 250000) {}
-
     }
 }
 
-void clear_combination() {
-    entry_stage = 0;
-    current_number = 0;
-    correct_direction = CLOCKWISE;
-    for (int i = 0; i < 3; i++) {
-        entered_combination[i] = 0xFF;
-        visible_counts[i] = 0;
+static void move_bolt(void *context, bool open) {
+    if (open) {
+        rotate_full_counterclockwise();
+    } else {
+        rotate_full_clockwise();
     }
 }
 
-void display_combination() {
-    char display[32] = "";
-    for (int i = 0; i < 3; i++) {
-        char temp[5];
-        if (i == entry_stage) {
-            sprintf(temp, "%02d", current_number);
-            strcat(display, temp);
-        } else if (entered_combination[i] != 0xFF) {
-            sprintf(temp, "%02d", entered_combination[i]);
-            strcat(display, temp);       
-        } else {
-            strcat(display, "  ");
-        }
-        if (i < 2) {
-            strcat(display, "-");
-        }
+static void show_pattern(void *context, lock_pattern_t pattern) {
+    if (pattern == LOCK_PATTERN_BAD_TRY) {
+        start_led_pattern(&BAD_TRY_PATTERN);
+    } else if (pattern == LOCK_PATTERN_ALARM) {
+        start_led_pattern(&ALARM_PATTERN);
+    } else if (led_pattern_is_active()) {
+        // stopping blanks the LEDs on the next tick, which would undo what the lock has just set
+        stop_led_pattern();
     }
-    display_string(1, display);
 }
- 
-void initialize_lock_controller() {
-    state = LOCKED;
-    entry_stage = 0;
-    correct_direction = CLOCKWISE;
-    bad_tries = 0;
-    timer = (cowpi_timer_t *) (0x40054000);
-    for (int i = 0; i < 3; i++) {
-        entered_combination[i] = 0xFF;
-        visible_counts[i] = 0;
-    }
-    current_number = 0;
-    cowpi_illuminate_left_led();
-    cowpi_deluminate_right_led();
-    rotate_full_clockwise();
-    display_combination();
+
+static void show_string(void *context, int row, char const *text) {
+    display_string(row, text);
 }
 
-void control_lock() {
-    direction_t dir = get_direction();
-    char result[16];
+static void save_combination(void *context, uint8_t const new_combination[]) {
+    memcpy(combination, new_combination, COMBINATION_LENGTH);
+    write_setting(SETTING_COMBINATION, combination, COMBINATION_LENGTH);
+}
+
+static void save_bad_tries(void *context, uint8_t bad_tries) {
+    write_setting(SETTING_BAD_TRIES, &bad_tries, 1);
+    emit_bad_tries_telemetry(bad_tries);
+}
+
+static void end_step(void *context, lock_state_t state, int bad_tries) {
+    journal_step(JOURNAL_OUTPUT(state, bad_tries));
+}
 
-    if (state == ALARMED) {
-        while (true) {
-            blink_leds();
-        }
-    } else if (state == LOCKED) {
-        
-        if (entry_stage < 3) {
-            if (dir == correct_direction) {
-                int dir_num = (correct_direction == CLOCKWISE) ? 1 : -1;
-                if (current_number + dir_num == combination[entry_stage]) {
-                    visible_counts[entry_stage]++;
-                }  
-                if (current_number < 15 && current_number > 0) {
-                    (correct_direction == CLOCKWISE) ? current_number++ : current_number--;
-                } else if (dir == CLOCKWISE) {
-                    if (current_number == 0) {
-                        current_number++;
-                    } else {
-                        current_number = 0;
-                    }
-                } else if (dir == COUNTERCLOCKWISE) {
-                    if (current_number == 15) {
-                        current_number--;
-                    } else {
-                        current_number = 15;
-                    }
-                } 
-            } else if (dir != correct_direction && dir != STATIONARY) {
-                entry_stage++;
-                correct_direction = (correct_direction == CLOCKWISE) ? COUNTERCLOCKWISE : CLOCKWISE;
-            }
-            entered_combination[entry_stage] = current_number;
-        } 
-        if (entry_stage > 1) {
-            if (dir == COUNTERCLOCKWISE) {
-                clear_combination();
-            }
-            if (cowpi_left_button_is_pressed()) {
-                if (check_combination()) {
-                    state = UNLOCKED;
-                } else {
-                    bad_tries++;
-                    if (bad_tries >= 3) {
-                        state = ALARMED;
-                    } else{
-                        clear_combination();
-                        blink_leds();
-                    }
-                }
-            }
-        }
-    } else if(state == UNLOCKED) {
-        if (cowpi_left_switch_is_in_right_position() && cowpi_right_button_is_pressed()) {
-            state = CHANGING;
-        }
-        if (cowpi_left_button_is_pressed() && cowpi_right_button_is_pressed()) {
-            clear_combination();
-            bad_tries = 0;
-            display_string(0, "");
-            state = LOCKED;
-        }
-    } else if(state == CHANGING) {
-        char combo_display[32] = "";
-        char part[6];
-        for (int i = 0; i < 6; i++) {
-            if (i == 3) {
-                strcat(combo_display, "    ");
-            }
-            if (new_combination[i] == 0xFF) {
-                strcat(combo_display, "  ");
-            } else {
-                sprintf(part, "%02d", new_combination[i]);
-                strcat(combo_display, part);
-            }
-            
-            strcat(combo_display, (i < 5 && i != 2) ? "-" : " ");
-        }
+static void change_state(void *context, lock_state_t from, lock_state_t to, int bad_tries) {
+    emit_state_telemetry(from, to);
+    record_flight_event(FLIGHT_STATE, from, to);
+    if (to == ALARMED) {
+        record_flight_event(FLIGHT_ALARM, (uint8_t) bad_tries, 0);
+    }
+}
 
-        key_t key = cowpi_get_keypress();
-        
-        if (key >= '0' && key <= '9' && digit_index < 6 && !handle_keypress) {
-            handle_key = key - '0';
-            handle_keypress = true;
-        }
-        if (handle_keypress && key == NULL) {
-            if (new_combination[digit_index] == 0xFF) {
-                new_combination[digit_index] = 0;
-                new_combination[digit_index] += 10 * handle_key;
-            } else {
-                new_combination[digit_index] += handle_key;
-                digit_index++;
-            }
-            handle_keypress = false;
-        }
-        if (cowpi_left_switch_is_in_left_position()) {
-            bool incomplete = false;
-            bool mismatch = false;
-            bool out_of_bounds = false;
+static lock_io_t const cowpi_lock_io = {
+        .take_detent_delta = take_detents,
+        .get_input_event = take_input_event,
+        .get_keypad_event = take_keypad_event,
+        .input_is_pressed = read_input,
+        .pattern_is_active = pattern_is_active,
+        .set_leds = set_leds,
+        .move_bolt = move_bolt,
+        .show_pattern = show_pattern,
+        .display_string = show_string,
+        .save_combination = save_combination,
+        .save_bad_tries = save_bad_tries,
+        .end_step = end_step,
+        .change_state = change_state,
+};
 
-            for (int i = 0; i < 3; i++) {
-                if (new_combination[i] == 0xFF || new_combination[i + 3] == 0xFF) {
-                    incomplete = true;
-                }
-                if (new_combination[i] != new_combination[i + 3]) {
-                    mismatch = true;
-                }
-                if (new_combination[i] > 15 || new_combination[i + 3] > 15) {
-                    out_of_bounds = true;
-                }
-            }
+uint8_t const *get_combination() {
+    return lock.combination;
+}
+ 
+lock_status_t get_lock_status() {
+    return (lock_status_t) {
+            .state = get_lock_state_name(lock.state), .entry_stage = lock.entry.entry_stage, .bad_tries = lock.bad_tries
+    };
+}
 
-            if (incomplete || mismatch || out_of_bounds) {
-                display_string(2, "no change");
-            } else {
-                for (int i = 0; i < 3; i++) {
-                    combination[i] = new_combination[i];
-                }
-                display_string(2, "changed");
-            }
-            state = UNLOCKED;
-            digit_index = 0;
-            for (int i = 0; i < 6 ; i++) {
-                new_combination[i] = 0xFF;
-            }
-        }
-        display_string(1, combo_display);
+void force_combination_reset() {
+    uint8_t const no_bad_tries = 0;
+    get_default_combination(combination);
+    memcpy(lock.combination, combination, COMBINATION_LENGTH);
+    write_setting(SETTING_COMBINATION, combination, COMBINATION_LENGTH);
+    write_setting(SETTING_BAD_TRIES, &no_bad_tries, 1);
+    // this only happens from test mode, where nothing else is running
+    while (service_settings_store()) {}
+}
+
+void initialize_lock_controller() {
+    int bad_tries = 0;
+    initialize_flight_recorder();
+    initialize_telemetry(get_telemetry_sink());
+    initialize_settings_store(get_flash_device());
+    uint8_t stored[SETTING_VALUE_SIZE];
+    if (read_setting(SETTING_COMBINATION, stored, SETTING_VALUE_SIZE) == COMBINATION_LENGTH) {
+        memcpy(combination, stored, COMBINATION_LENGTH);
     }
-    if (state == LOCKED) {
-        cowpi_illuminate_left_led();
-        cowpi_deluminate_right_led();
-        rotate_full_clockwise();
-        if (bad_tries > 0) {
-            char temp[19];
-            sprintf(temp, "%s%d", "bad try ", bad_tries);
-            display_string(0, temp);
-        }
-        display_string(2, " ");
-        display_combination();
-    } else if (state == UNLOCKED) {
-        cowpi_deluminate_left_led();
-        cowpi_illuminate_right_led();
-        rotate_full_counterclockwise();
-        display_string(0, "OPEN");
-        display_string(1, " ");
-    } else if (state == ALARMED) {
-        display_string(0, "alert!");
-        display_string(1, " ");
-    } else if (state == CHANGING) {
-        display_string(0, "enter");
+    if (read_setting(SETTING_BAD_TRIES, stored, 1) == 1) {
+        bad_tries = stored[0];
     }
-    
+    initialize_led_patterns();
+    initialize_keypad();
+    initialize_input_events();
+    initialize_lock_instance(&lock, &cowpi_lock_io, NULL, combination, bad_tries);
+    if (lock.state == ALARMED) {
+        record_flight_event(FLIGHT_ALARM, (uint8_t) bad_tries, 0);
+    }
+    start_input_journal(combination, (uint8_t) bad_tries);
+    journal_step(JOURNAL_OUTPUT(lock.state, bad_tries));
+    emit_state_telemetry(lock.state, lock.state);
+    emit_bad_tries_telemetry((uint8_t) bad_tries);
+}
+
+void control_lock() {
+    service_settings_store();
+    control_lock_instance(&lock);
 }
- 
- 
- 
-  
- 
- 
- 
\ No newline at end of file
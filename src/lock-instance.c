@@ -0,0 +1,266 @@
+/**************************************************************************//**
+ *
+ * @file lock-instance.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to implement the "combination lock" mode for one instance of
+ *      the lock.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "lock-instance.h"
+
+static char const *const state_names[] = {
+        [LOCKED] = "LOCKED", [UNLOCKED] = "UNLOCKED", [CHANGING] = "CHANGING", [ALARMED] = "ALARMED"
+};
+static char const *const status_text[] = {
+        [LOCKED] = " ", [UNLOCKED] = "OPEN", [CHANGING] = "enter", [ALARMED] = "alert!"
+};
+
+char const *get_lock_state_name(lock_state_t state) {
+    return (state < NUMBER_OF_LOCK_STATES) ? state_names[state] : "?";
+}
+
+static void set_leds(lock_instance_t const *lock, bool left, bool right) {
+    if (lock->io->set_leds) {
+        lock->io->set_leds(lock->context, left, right);
+    }
+}
+
+static void move_bolt(lock_instance_t const *lock, bool open) {
+    if (lock->io->move_bolt) {
+        lock->io->move_bolt(lock->context, open);
+    }
+}
+
+static void show_pattern(lock_instance_t const *lock, lock_pattern_t pattern) {
+    if (lock->io->show_pattern) {
+        lock->io->show_pattern(lock->context, pattern);
+    }
+}
+
+static void display_string(lock_instance_t const *lock, int row, char const *text) {
+    lock->io->display_string(lock->context, row, text);
+}
+
+static void set_bad_tries(lock_instance_t *lock, int tries) {
+    lock->bad_tries = tries;
+    if (lock->io->save_bad_tries) {
+        lock->io->save_bad_tries(lock->context, (uint8_t) tries);
+    }
+}
+
+static void format_number(char *buffer, uint8_t number) {
+    char temp[5];
+    if (number == NO_NUMBER) {
+        strcat(buffer, "  ");
+    } else {
+        sprintf(temp, "%02d", number);
+        strcat(buffer, temp);
+    }
+}
+
+static void format_combination(char *buffer, uint8_t const digits[]) {
+    buffer[0] = '\0';
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        format_number(buffer, digits[i]);
+        if (i < COMBINATION_LENGTH - 1) {
+            strcat(buffer, "-");
+        }
+    }
+}
+
+/* A new combination and its confirmation share row 1 when they fit in 21
+ * columns (up to three numbers); longer combinations put the confirmation on
+ * row 3. */
+#define CONFIRMATION_ROW    ((6 * COMBINATION_LENGTH + 2 <= 21) ? 1 : 3)
+
+static void format_new_combination(char *buffer, uint8_t const digits[]) {
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        format_number(buffer, digits[i]);
+        strcat(buffer, (i < COMBINATION_LENGTH - 1) ? "-" : " ");
+    }
+}
+
+static void update_view(lock_instance_t *lock) {
+    lock_view_t *view = &lock->view;
+    view->state = lock->state;
+    view->bad_tries = lock->bad_tries;
+    view->entry_stage = lock->entry.entry_stage;
+    get_displayed_numbers(&lock->entry, view->digits);
+    memcpy(view->new_digits, lock->new_combination.numbers, sizeof(view->new_digits));
+}
+
+static void render_view(lock_instance_t *lock) {
+    lock_view_t const *view = &lock->view;
+    lock_view_t const *rendered_view = &lock->rendered_view;
+    bool state_changed = !lock->view_is_rendered || view->state != rendered_view->state;
+    char row[32];
+    if (state_changed || view->bad_tries != rendered_view->bad_tries) {
+        if (view->state == LOCKED && view->bad_tries > 0) {
+            sprintf(row, "%s%d", "bad try ", view->bad_tries);
+            display_string(lock, 0, row);
+        } else {
+            display_string(lock, 0, status_text[view->state]);
+        }
+    }
+    if (view->state == LOCKED) {
+        if (state_changed || memcmp(view->digits, rendered_view->digits, sizeof(view->digits))) {
+            format_combination(row, view->digits);
+            display_string(lock, 1, row);
+        }
+    } else if (view->state == CHANGING) {
+        if (state_changed || memcmp(view->new_digits, rendered_view->new_digits, sizeof(view->new_digits))) {
+            row[0] = '\0';
+            format_new_combination(row, view->new_digits);
+            if (CONFIRMATION_ROW == 1) {
+                strcat(row, "    ");
+            } else {
+                display_string(lock, 1, row);
+                row[0] = '\0';
+            }
+            format_new_combination(row + strlen(row), view->new_digits + COMBINATION_LENGTH);
+            display_string(lock, CONFIRMATION_ROW, row);
+        }
+    } else if (state_changed) {
+        display_string(lock, 1, " ");
+    }
+    if (CONFIRMATION_ROW != 1 && state_changed && rendered_view->state == CHANGING) {
+        display_string(lock, CONFIRMATION_ROW, " ");
+    }
+    if (!lock->view_is_rendered || view->message != rendered_view->message) {
+        display_string(lock, 2, view->message ? view->message : " ");
+    }
+    lock->rendered_view = *view;
+    lock->view_is_rendered = true;
+}
+
+static void refresh_view(lock_instance_t *lock) {
+    if (lock->io->display_string) {
+        update_view(lock);
+        render_view(lock);
+    }
+}
+
+void initialize_lock_instance(lock_instance_t *lock, lock_io_t const *io, void *context,
+                              uint8_t const combination[], int bad_tries) {
+    lock->io = io;
+    lock->context = context;
+    lock->state = LOCKED;
+    memcpy(lock->combination, combination, COMBINATION_LENGTH);
+    lock->bad_tries = bad_tries;
+    clear_combination_entry(&lock->entry);
+    clear_new_combination(&lock->new_combination);
+    set_leds(lock, true, false);
+    move_bolt(lock, false);
+    if (bad_tries >= MAXIMUM_BAD_TRIES) {
+        // power-cycling the lock is not a way out of the alarm
+        show_pattern(lock, LOCK_PATTERN_ALARM);
+        lock->state = ALARMED;
+    }
+    lock->reported_state = lock->state;
+    lock->view.message = NULL;
+    lock->view_is_rendered = false;
+    refresh_view(lock);
+}
+
+void control_lock_instance(lock_instance_t *lock) {
+    lock_io_t const *io = lock->io;
+    void *context = lock->context;
+    int detents = io->take_detent_delta(context);
+    keypad_event_t key_event;
+    input_event_t input_event;
+    bool left_button_pressed = false;
+    bool right_button_pressed = false;
+    // act on presses, not on levels, so that holding a button is a single action
+    while (io->get_input_event(context, &input_event)) {
+        if (input_event.type == INPUT_PRESSED) {
+            left_button_pressed |= (input_event.input == LEFT_BUTTON);
+            right_button_pressed |= (input_event.input == RIGHT_BUTTON);
+        }
+    }
+
+    if (lock->state == ALARMED) {
+        // the alarm pattern plays until the lock is reset; there is no way out of this state
+    } else if (lock->state == LOCKED) {
+        turn_dial_by(&lock->entry, detents, lock->combination);
+        if (combination_entry_is_final(&lock->entry) && left_button_pressed) {
+            if (combination_entry_matches(&lock->entry, lock->combination)) {
+                show_pattern(lock, LOCK_PATTERN_NONE);
+                lock->state = UNLOCKED;
+            } else {
+                set_bad_tries(lock, lock->bad_tries + 1);
+                if (lock->bad_tries >= MAXIMUM_BAD_TRIES) {
+                    show_pattern(lock, LOCK_PATTERN_ALARM);
+                    lock->state = ALARMED;
+                } else {
+                    clear_combination_entry(&lock->entry);
+                    show_pattern(lock, LOCK_PATTERN_BAD_TRY);
+                }
+            }
+        }
+    } else if (lock->state == UNLOCKED) {
+        if (io->input_is_pressed(context, LEFT_SWITCH) && right_button_pressed) {
+            lock->state = CHANGING;
+        }
+        if ((left_button_pressed && io->input_is_pressed(context, RIGHT_BUTTON))
+            || (right_button_pressed && io->input_is_pressed(context, LEFT_BUTTON))) {
+            clear_combination_entry(&lock->entry);
+            set_bad_tries(lock, 0);
+            lock->state = LOCKED;
+        }
+    } else if (lock->state == CHANGING) {
+        // a digit counts when its key is released
+        while (io->get_keypad_event(context, &key_event)) {
+            if (!key_event.pressed && key_event.key >= '0' && key_event.key <= '9') {
+                enter_new_combination_digit(&lock->new_combination, key_event.key - '0');
+            }
+        }
+        if (!io->input_is_pressed(context, LEFT_SWITCH)) {
+            if (!new_combination_is_acceptable(&lock->new_combination)) {
+                lock->view.message = "no change";
+            } else {
+                memcpy(lock->combination, lock->new_combination.numbers, COMBINATION_LENGTH);
+                if (io->save_combination) {
+                    io->save_combination(context, lock->combination);
+                }
+                lock->view.message = "changed";
+            }
+            lock->state = UNLOCKED;
+            clear_new_combination(&lock->new_combination);
+        }
+    }
+    if (lock->state != CHANGING) {
+        // keys pressed outside of CHANGING must not turn up as digits later
+        while (io->get_keypad_event(context, &key_event)) {}
+    }
+    if (lock->state == LOCKED) {
+        if (!io->pattern_is_active(context)) {
+            set_leds(lock, true, false);
+        }
+        move_bolt(lock, false);
+        lock->view.message = NULL;
+    } else if (lock->state == UNLOCKED) {
+        set_leds(lock, false, true);
+        move_bolt(lock, true);
+    }
+    refresh_view(lock);
+    if (io->end_step) {
+        io->end_step(context, lock->state, lock->bad_tries);
+    }
+    if (lock->state != lock->reported_state) {
+        if (io->change_state) {
+            io->change_state(context, lock->reported_state, lock->state, lock->bad_tries);
+        }
+        lock->reported_state = lock->state;
+    }
+}
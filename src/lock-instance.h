@@ -0,0 +1,125 @@
+/**************************************************************************//**
+ *
+ * @file lock-instance.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The combination lock's state machine as an instance, with all of its
+ *      input and output through callbacks, so that any number of locks can
+ *      run in one process.
+ *
+ * lock-controller.c owns the one instance on the CowPi and wires its
+ * callbacks to the keypad, input events, LEDs, servo, display, settings
+ * store, telemetry and journal; host/fleet.c runs thousands of them against
+ * simulated input. Nothing here touches a global, so separate instances may
+ * run on separate threads.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_LOCK_INSTANCE_H
+#define COMBOLOCK_LOCK_INSTANCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "combination-engine.h"
+#include "input-events.h"
+#include "keypad.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAXIMUM_BAD_TRIES   (3)
+
+typedef enum {
+    LOCKED, UNLOCKED, CHANGING, ALARMED, NUMBER_OF_LOCK_STATES
+} lock_state_t;
+
+typedef enum {
+    LOCK_PATTERN_NONE, LOCK_PATTERN_BAD_TRY, LOCK_PATTERN_ALARM
+} lock_pattern_t;
+
+/**
+ * A lock's input and output. The input callbacks are required; any output
+ * callback may be NULL, and without display_string the display is not
+ * formatted at all. Every callback is passed the instance's `context`.
+ */
+typedef struct {
+    // the net detents turned since the last call, positive clockwise
+    int (*take_detent_delta)(void *context);
+    // pops the next pushbutton or switch event, if there is one
+    bool (*get_input_event)(void *context, input_event_t *event);
+    // pops the next key event, if there is one
+    bool (*get_keypad_event)(void *context, keypad_event_t *event);
+    // the debounced level of a pushbutton or switch
+    bool (*input_is_pressed)(void *context, input_t input);
+    // whether an LED pattern is still playing, which leaves the LEDs to it
+    bool (*pattern_is_active)(void *context);
+
+    void (*set_leds)(void *context, bool left, bool right);
+    void (*move_bolt)(void *context, bool open);
+    void (*show_pattern)(void *context, lock_pattern_t pattern);
+    void (*display_string)(void *context, int row, char const *text);
+    void (*save_combination)(void *context, uint8_t const combination[]);
+    void (*save_bad_tries)(void *context, uint8_t bad_tries);
+    // after every control_lock_instance(), for the input journal
+    void (*end_step)(void *context, lock_state_t state, int bad_tries);
+    void (*change_state)(void *context, lock_state_t from, lock_state_t to, int bad_tries);
+} lock_io_t;
+
+/* What the display currently shows is a function of this view model; rows are
+ * only re-formatted and re-sent when the fields they depend on change. */
+typedef struct {
+    lock_state_t state;
+    int bad_tries;
+    int entry_stage;
+    uint8_t digits[COMBINATION_LENGTH];
+    uint8_t new_digits[NEW_COMBINATION_LENGTH];
+    char const *message;
+} lock_view_t;
+
+typedef struct {
+    lock_io_t const *io;
+    void *context;
+    lock_state_t state;
+    lock_state_t reported_state;
+    uint8_t combination[COMBINATION_LENGTH];
+    int bad_tries;
+    combination_entry_t entry;
+    new_combination_t new_combination;
+    lock_view_t view;
+    lock_view_t rendered_view;
+    bool view_is_rendered;
+} lock_instance_t;
+
+/**
+ * Starts a lock in LOCKED, or in ALARMED if it has already had
+ * MAXIMUM_BAD_TRIES bad tries, sets its LEDs and bolt, and draws its display.
+ *
+ * @param lock The instance to start
+ * @param io The lock's callbacks, which must outlive it
+ * @param context Passed to each callback
+ * @param combination The stored combination
+ * @param bad_tries The stored number of bad tries
+ */
+void initialize_lock_instance(lock_instance_t *lock, lock_io_t const *io, void *context,
+                              uint8_t const combination[], int bad_tries);
+
+/**
+ * Consumes the lock's pending input and acts on it.
+ */
+void control_lock_instance(lock_instance_t *lock);
+
+char const *get_lock_state_name(lock_state_t state);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_LOCK_INSTANCE_H
@@ -0,0 +1,40 @@
+/**************************************************************************//**
+ *
+ * @file lock-status.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A snapshot of the lock controller's state, for the console and the
+ *      tests.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_LOCK_STATUS_H
+#define COMBOLOCK_LOCK_STATUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    char const *state;
+    int entry_stage;
+    int bad_tries;
+} lock_status_t;
+
+/**
+ * @return The lock's state, by name, its entry stage and its bad tries
+ */
+lock_status_t get_lock_status(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_LOCK_STATUS_H
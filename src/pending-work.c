@@ -0,0 +1,116 @@
+/**************************************************************************//**
+ *
+ * @file pending-work.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code for the work flags and the event-driven run mode.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "interrupt_support.h"
+#include "pending-work.h"
+#include "time-service.h"
+
+#ifdef COMBOLOCK_HOST
+#include "host-hal.h"
+#endif
+
+#define WAKE_TIMER          (0)     // one-shot
+
+static uint32_t volatile pending_work = 0;
+static idle_metrics_t metrics;
+static uint64_t last_wake;
+static idle_metrics_t last_report;
+
+static void handle_wake_interrupt() {
+    post_work(WORK_TICK);
+}
+
+void initialize_pending_work(void) {
+    memset(&metrics, 0, sizeof(metrics));
+    last_wake = get_time_us();
+}
+
+void post_work(uint32_t flags) {
+    uint32_t primask = disable_interrupts();
+    pending_work |= flags;
+    restore_interrupts(primask);
+}
+
+/* Waits for any interrupt, which has run by the time this returns. */
+#ifdef __MBED__
+static inline void sleep_until_interrupt(uint32_t primask) {
+    // an interrupt that became pending since the flags were checked still ends the WFI
+    __asm volatile ("wfi" : : : "memory");
+    restore_interrupts(primask);
+}
+#else
+static inline void sleep_until_interrupt(uint32_t primask) {
+    wait_for_host_interrupt();
+    restore_interrupts(primask);
+}
+#endif //__MBED__
+
+uint32_t wait_for_work(uint32_t wake_us) {
+    uint64_t now = get_time_us();
+    metrics.elapsed_us += now - last_wake;
+    int32_t delay_us = (int32_t) (wake_us - (uint32_t) now);
+    if (delay_us > WORK_TICK_PERIOD_MS * 1000) {
+        delay_us = WORK_TICK_PERIOD_MS * 1000;
+    }
+    if (delay_us > 0) {
+        register_one_shot_timer_ISR(WAKE_TIMER, (uint32_t) delay_us, handle_wake_interrupt);
+    } else {
+        post_work(WORK_TICK);
+    }
+    uint32_t primask = disable_interrupts();
+    while (pending_work == 0) {
+        uint64_t start = get_time_us();
+        sleep_until_interrupt(primask);
+        metrics.idle_us += get_time_us() - start;
+        metrics.wakeups++;
+        primask = disable_interrupts();
+    }
+    uint32_t work = pending_work;
+    pending_work = 0;
+    restore_interrupts(primask);
+    metrics.work_wakeups++;
+    uint64_t woke = get_time_us();
+    metrics.elapsed_us += woke - now;
+    last_wake = woke;
+    return work;
+}
+
+uint32_t take_work(void) {
+    uint32_t primask = disable_interrupts();
+    uint32_t work = pending_work;
+    pending_work = 0;
+    restore_interrupts(primask);
+    return work;
+}
+
+idle_metrics_t get_idle_metrics(void) {
+    return metrics;
+}
+
+void report_idle_time(void) {
+    uint64_t elapsed = metrics.elapsed_us - last_report.elapsed_us;
+    if (elapsed < (uint64_t) IDLE_REPORT_PERIOD_MS * 1000) {
+        return;
+    }
+    uint64_t idle = metrics.idle_us - last_report.idle_us;
+    printf("idle %lu.%lu%% of %lu ms, %lu wakeups, %lu with work\n",
+           (unsigned long) (idle * 1000 / elapsed / 10), (unsigned long) (idle * 1000 / elapsed % 10),
+           (unsigned long) (elapsed / 1000), (unsigned long) (metrics.wakeups - last_report.wakeups),
+           (unsigned long) (metrics.work_wakeups - last_report.work_wakeups));
+    last_report = metrics;
+}
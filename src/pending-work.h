@@ -0,0 +1,91 @@
+/**************************************************************************//**
+ *
+ * @file pending-work.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Flags that ISRs raise when they leave work for the main loop, and
+ *      the event-driven run mode that sleeps until one is raised.
+ *
+ * Built with <code>-DCOMBOLOCK_TICKLESS</code>, loop() waits in
+ * wait_for_work() instead of spinning: the core sleeps with WFI and is woken
+ * by every interrupt, but goes back to sleep unless an ISR posted work. A
+ * one-shot alarm posts WORK_TICK when the earliest task delay or timeout runs
+ * out, so that time-driven housekeeping (the watchdog, telemetry, settings
+ * writes) still happens on time while nobody touches the lock; the core never
+ * sleeps longer than WORK_TICK_PERIOD_MS. Without the flag, posting work costs
+ * a few stores and loop() runs back-to-back as before.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_PENDING_WORK_H
+#define COMBOLOCK_PENDING_WORK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WORK_TICK_PERIOD_MS     (100)     // the longest sleep
+#define IDLE_REPORT_PERIOD_MS   (10000)
+
+typedef enum {
+    WORK_DETENT = 1 << 0,       // the dial turned
+    WORK_INPUT = 1 << 1,        // a button or switch event was queued
+    WORK_KEYPAD = 1 << 2,       // a keypad event was queued
+    WORK_LEDS = 1 << 3,         // an LED pattern finished
+    WORK_TICK = 1 << 4,         // the wake-up alarm went off
+    WORK_DEFERRED = 1 << 5,     // an item was posted to the deferred-work queues
+} work_flag_t;
+
+typedef struct {
+    uint64_t elapsed_us;
+    uint64_t idle_us;
+    uint32_t wakeups;           // every interrupt that woke the core
+    uint32_t work_wakeups;      // those that left work
+} idle_metrics_t;
+
+/**
+ * Starts the idle metrics. Call at the end of setup().
+ */
+void initialize_pending_work(void);
+
+/**
+ * Raises the given work flags. Safe to call from ISRs.
+ */
+void post_work(uint32_t flags);
+
+/**
+ * Sleeps until at least one work flag is raised, then clears and returns
+ * them. WORK_TICK is raised at `wake_us`, or WORK_TICK_PERIOD_MS from now if
+ * that is sooner; a `wake_us` that has already passed returns at once.
+ *
+ * @param wake_us The time, on the time-service clock's low 32 bits, that
+ *      loop() must run again by
+ */
+uint32_t wait_for_work(uint32_t wake_us);
+
+/**
+ * Clears and returns the work flags that are raised, without waiting.
+ */
+uint32_t take_work(void);
+
+idle_metrics_t get_idle_metrics(void);
+
+/**
+ * Prints the idle duty cycle over Serial every IDLE_REPORT_PERIOD_MS.
+ */
+void report_idle_time(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_PENDING_WORK_H
@@ -0,0 +1,116 @@
+/**************************************************************************//**
+ *
+ * @file profiler.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to gather the profiler's zone timings into once-a-second
+ *      reports.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "display.h"
+#include "profiler.h"
+
+#ifdef COMBOLOCK_PROFILE
+
+#define TICKS_PER_PERIOD    ((uint32_t) PROFILE_REPORT_PERIOD_MS * 1000 * PROFILER_TICKS_PER_US)
+
+static char const *zone_names[NUMBER_OF_PROFILE_ZONES] = {
+        "control_lock", "test mode", "refresh_display", "background"
+};
+static char const zone_letters[NUMBER_OF_PROFILE_ZONES] = {'L', 'T', 'R', 'B'};
+
+profile_zone_stats_t profile_zones[NUMBER_OF_PROFILE_ZONES];
+
+static uint32_t period_start;
+static uint32_t iterations = 0;
+static bool period_started = false;
+static profile_report_t report;
+static bool report_is_fresh = false;
+
+void profile_loop_iteration(void) {
+    uint32_t now = read_profiler_clock();
+    if (!period_started) {
+        period_start = now;
+        period_started = true;
+        memset(profile_zones, 0, sizeof(profile_zones));
+        return;
+    }
+    iterations++;
+    uint32_t elapsed = now - period_start;
+    if (elapsed < TICKS_PER_PERIOD) {
+        return;
+    }
+    report.loops_per_second = (uint32_t) ((uint64_t) iterations * 1000000 * PROFILER_TICKS_PER_US / elapsed);
+    memcpy(report.zones, profile_zones, sizeof(profile_zones));
+    for (int i = 0; i < NUMBER_OF_PROFILE_ZONES; i++) {
+        if (profile_zones[i].worst_ticks > report.worst_ever_ticks[i]) {
+            report.worst_ever_ticks[i] = profile_zones[i].worst_ticks;
+        }
+    }
+    memset(profile_zones, 0, sizeof(profile_zones));
+    iterations = 0;
+    period_start = now;
+    report_is_fresh = true;
+}
+
+bool get_profile_report(profile_report_t *copy) {
+    if (!report_is_fresh) {
+        return false;
+    }
+    *copy = report;
+    report_is_fresh = false;
+    return true;
+}
+
+static uint32_t average_ns(profile_zone_stats_t const *stats) {
+    return stats->count ? (uint32_t) ((uint64_t) stats->total_ticks * 1000 / PROFILER_TICKS_PER_US / stats->count) : 0;
+}
+
+static uint32_t average_us(profile_zone_stats_t const *stats) {
+    return average_ns(stats) / 1000;
+}
+
+void report_profile(int first_row) {
+    profile_report_t current;
+    if (!get_profile_report(&current)) {
+        return;
+    }
+    printf("profile: %lu loops/s\n", (unsigned long) current.loops_per_second);
+    for (int i = 0; i < NUMBER_OF_PROFILE_ZONES; i++) {
+        profile_zone_stats_t const *stats = &current.zones[i];
+        uint32_t average = average_ns(stats);
+        printf("  %-16s %7lu runs %7lu us total %5lu.%03lu us avg %5lu us worst %5lu us worst ever\n",
+               zone_names[i], (unsigned long) stats->count,
+               (unsigned long) (stats->total_ticks / PROFILER_TICKS_PER_US),
+               (unsigned long) (average / 1000), (unsigned long) (average % 1000),
+               (unsigned long) (stats->worst_ticks / PROFILER_TICKS_PER_US),
+               (unsigned long) (current.worst_ever_ticks[i] / PROFILER_TICKS_PER_US));
+    }
+    if (first_row < 0) {
+        return;
+    }
+    // avg/worst in microseconds, two zones to a row
+    char row[64];
+    snprintf(row, sizeof(row), "loops/s %lu", (unsigned long) current.loops_per_second);
+    display_string(first_row, row);
+    for (int i = 0; i < NUMBER_OF_PROFILE_ZONES; i += 2) {
+        snprintf(row, sizeof(row), "%c%4lu/%-5lu%c%4lu/%lu",
+                 zone_letters[i], (unsigned long) average_us(&current.zones[i]),
+                 (unsigned long) (current.zones[i].worst_ticks / PROFILER_TICKS_PER_US),
+                 zone_letters[i + 1], (unsigned long) average_us(&current.zones[i + 1]),
+                 (unsigned long) (current.zones[i + 1].worst_ticks / PROFILER_TICKS_PER_US));
+        row[21] = '\0';
+        display_string(first_row + 1 + i / 2, row);
+    }
+}
+
+#endif //COMBOLOCK_PROFILE
@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ *
+ * @file profiler.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A lightweight profiler that times scoped zones of the main loop and
+ *      reports per-zone totals, worst cases and the loop-iteration rate once a
+ *      second.
+ *
+ * Build with <code>-DCOMBOLOCK_PROFILE</code> to enable it. Without that flag
+ * the macros expand to nothing and the profiler costs nothing.
+ *
+ * The Cortex-M0+ has no cycle counter, so on the RP2040 zones are timed with
+ * the 1MHz timer; one raw read costs a few cycles. On the host they are timed
+ * in nanoseconds.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_PROFILER_H
+#define COMBOLOCK_PROFILER_H
+
+#include <CowPi.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "registers.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PROFILE_CONTROL_LOCK,
+    PROFILE_TEST_MODE,
+    PROFILE_REFRESH_DISPLAY,
+    PROFILE_BACKGROUND,         // deferred work, telemetry, stack scans and the console
+    NUMBER_OF_PROFILE_ZONES
+} profile_zone_t;
+
+#ifdef COMBOLOCK_PROFILE
+
+#define PROFILE_REPORT_PERIOD_MS    (1000)
+
+typedef struct {
+    uint32_t count;
+    uint32_t total_ticks;
+    uint32_t worst_ticks;
+} profile_zone_stats_t;
+
+typedef struct {
+    uint32_t loops_per_second;
+    profile_zone_stats_t zones[NUMBER_OF_PROFILE_ZONES];
+    uint32_t worst_ever_ticks[NUMBER_OF_PROFILE_ZONES];
+} profile_report_t;
+
+typedef struct {
+    uint8_t zone;
+    uint32_t start;
+} profile_scope_t;
+
+#ifdef COMBOLOCK_HOST
+#define PROFILER_TICKS_PER_US       (1000)
+uint32_t get_host_clock_ns(void);
+static inline uint32_t read_profiler_clock(void) {
+    return get_host_clock_ns();
+}
+#else
+#define PROFILER_TICKS_PER_US       (1)
+static inline uint32_t read_profiler_clock(void) {
+    return TIMER_REGISTERS->raw_lower_word;
+}
+#endif //COMBOLOCK_HOST
+
+extern profile_zone_stats_t profile_zones[NUMBER_OF_PROFILE_ZONES];
+
+static inline void end_profile_zone(profile_scope_t const *scope) {
+    uint32_t elapsed = read_profiler_clock() - scope->start;
+    profile_zone_stats_t *stats = &profile_zones[scope->zone];
+    stats->count++;
+    stats->total_ticks += elapsed;
+    if (elapsed > stats->worst_ticks) {
+        stats->worst_ticks = elapsed;
+    }
+}
+
+/**
+ * Counts one loop() iteration, and closes the reporting period once
+ * PROFILE_REPORT_PERIOD_MS has passed.
+ */
+void profile_loop_iteration(void);
+
+/**
+ * Prints the most recent report over Serial and, if `first_row` is not
+ * negative, shows it on the three display rows starting there. Does nothing
+ * unless a reporting period has closed since the last call.
+ */
+void report_profile(int first_row);
+
+/**
+ * @param report Receives the statistics from the most recently closed period
+ * @return <code>true</code> if a period has closed since the last call
+ */
+bool get_profile_report(profile_report_t *report);
+
+#define PROFILE_CONCATENATE_(a, b)  a##b
+#define PROFILE_CONCATENATE(a, b)   PROFILE_CONCATENATE_(a, b)
+
+/** Times from here to the end of the enclosing block. */
+#define PROFILE_ZONE(zone)                                                          \
+    profile_scope_t PROFILE_CONCATENATE(profile_scope_, __LINE__)                   \
+            __attribute__((cleanup(end_profile_zone))) = {(zone), read_profiler_clock()}
+#define PROFILE_LOOP()              profile_loop_iteration()
+#define PROFILE_REPORT(first_row)   report_profile(first_row)
+
+#else
+
+#define PROFILE_ZONE(zone)          do {} while (0)
+#define PROFILE_LOOP()              do {} while (0)
+#define PROFILE_REPORT(first_row)   do {} while (0)
+
+#endif //COMBOLOCK_PROFILE
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_PROFILER_H
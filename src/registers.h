@@ -0,0 +1,40 @@
+/**************************************************************************//**
+ *
+ * @file registers.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Where the RP2040's register blocks live, named once for the C code;
+ *      C++ code should use the typed pins in registers.hpp instead.
+ *
+ * On the host, cowpi-hal.c maps ordinary memory at these same addresses, so
+ * code that goes through them runs unchanged against the stand-ins.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_REGISTERS_H
+#define COMBOLOCK_REGISTERS_H
+
+#include <CowPi.h>
+
+#define SIO_BASE                (0xD0000000)
+#define TIMER_BASE              (0x40054000)
+#define IO_BANK0_BASE           (0x40014000)
+
+/* Writing through these aliases of a peripheral register (but not of SIO,
+ * which has its own set, clear and toggle registers) changes only the bits
+ * that are written as 1. */
+#define REGISTER_XOR_ALIAS      (0x1000)
+#define REGISTER_SET_ALIAS      (0x2000)
+#define REGISTER_CLEAR_ALIAS    (0x3000)
+
+#define SIO_REGISTERS           ((cowpi_ioport_t volatile *) SIO_BASE)
+#define TIMER_REGISTERS         ((cowpi_timer_t volatile *) TIMER_BASE)
+
+#endif //COMBOLOCK_REGISTERS_H
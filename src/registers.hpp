@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ *
+ * @file registers.hpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Typed access to the SIO block and the timer, with each GPIO pin a
+ *      type of its own, so that the pin number and its mask are settled at
+ *      compile time and every access is a single load or store.
+ *
+ * Reading a pin loads GPIO_IN; setting, clearing or toggling an output pin is
+ * one store to GPIO_OUT_SET, GPIO_OUT_CLR or GPIO_OUT_XOR, which also makes
+ * them safe against an ISR or the other core changing a different pin
+ * between a read and a write. On the host the same code runs against the
+ * memory that cowpi-hal.c maps at the SIO and timer addresses.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_REGISTERS_HPP
+#define COMBOLOCK_REGISTERS_HPP
+
+#include <stdint.h>
+#include "registers.h"
+
+namespace combolock {
+namespace registers {
+
+constexpr unsigned NUMBER_OF_GPIO_PINS = 30;
+
+template<typename Block, uintptr_t Base>
+struct peripheral {
+    static constexpr uintptr_t base = Base;
+
+    static Block volatile &get() {
+        return *reinterpret_cast<Block volatile *>(Base);
+    }
+};
+
+typedef peripheral<cowpi_ioport_t, SIO_BASE> sio;
+typedef peripheral<cowpi_timer_t, TIMER_BASE> timer;
+
+#ifdef COMBOLOCK_HOST
+/* The host's stand-in for SIO is plain memory, where a store to an alias
+ * changes nothing else, so the aliases' effect on GPIO_OUT is done here. */
+struct sio_output {
+    static void set(uint32_t mask) {
+        sio::get().output |= mask;
+    }
+
+    static void clear(uint32_t mask) {
+        sio::get().output &= ~mask;
+    }
+
+    static void toggle(uint32_t mask) {
+        sio::get().output ^= mask;
+    }
+};
+#else
+struct sio_output {
+    static void set(uint32_t mask) {
+        sio::get().output_set = mask;
+    }
+
+    static void clear(uint32_t mask) {
+        sio::get().output_clear = mask;
+    }
+
+    static void toggle(uint32_t mask) {
+        sio::get().output_toggle = mask;
+    }
+};
+#endif //COMBOLOCK_HOST
+
+/* A run of `Width` adjacent GPIO pins starting at `First`, read together. */
+template<unsigned First, unsigned Width = 1>
+struct gpio_pins {
+    static_assert(Width > 0 && First + Width <= NUMBER_OF_GPIO_PINS, "the RP2040 has GPIO 0-29");
+
+    static constexpr unsigned first = First;
+    static constexpr uint32_t mask = ((1u << Width) - 1) << First;
+
+    // the pins' input levels, shifted down so that `First` is bit 0
+    static uint32_t read() {
+        return (sio::get().input & mask) >> First;
+    }
+
+    // the levels the pins are being driven to, shifted likewise
+    static uint32_t read_output() {
+        return (sio::get().output & mask) >> First;
+    }
+
+    static void set() {
+        sio_output::set(mask);
+    }
+
+    static void clear() {
+        sio_output::clear(mask);
+    }
+
+    static void toggle() {
+        sio_output::toggle(mask);
+    }
+};
+
+template<unsigned Pin>
+struct gpio_pin : gpio_pins<Pin> {
+    static bool is_high() {
+        return sio::get().input & gpio_pins<Pin>::mask;
+    }
+
+    static bool is_driven_high() {
+        return sio::get().output & gpio_pins<Pin>::mask;
+    }
+
+    static void write(bool high) {
+        if (high) {
+            gpio_pins<Pin>::set();
+        } else {
+            gpio_pins<Pin>::clear();
+        }
+    }
+};
+
+} // namespace registers
+} // namespace combolock
+
+#endif //COMBOLOCK_REGISTERS_HPP
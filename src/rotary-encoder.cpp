@@ -1,6 +1,6 @@
 /**************************************************************************//**
  *
- * @file rotary-encoder.c
+ * @file rotary-encoder.cpp
  *
  * @author (STUDENTS -- Nolan Hill)
  * @author (STUDENTS -- Nick Goertzen)
@@ -15,11 +15,23 @@
  */
 
  #include <CowPi.h>
- #include "interrupt_support.h"
+ 
+ extern "C" {
  #include "rotary-encoder.h"
+ }
+ 
+ #include "critical-section.h"
+ #include "detent-delta.h"
+ #include "input-journal.h"
+ #include "interrupt_support.h"
+ #include "pending-work.h"
+ #include "registers.hpp"
+ #include "telemetry.h"
  
  #define A_WIPER_PIN         (16)
- #define B_WIPER_PIN         (A_WIPER_PIN + 1)
+ 
+ // the A wiper in bit 0 and the B wiper in bit 1
+ typedef combolock::registers::gpio_pins<A_WIPER_PIN, 2> wiper_pins;
  
  typedef enum {
      HIGH_HIGH, HIGH_LOW, LOW_LOW, LOW_HIGH, UNKNOWN
@@ -29,13 +41,12 @@
  static direction_t volatile direction = STATIONARY;
  static int volatile clockwise_count = 0;
  static int volatile counterclockwise_count = 0;
- 
- static cowpi_ioport_t volatile *ioport;
+ static int volatile detent_delta = 0;
  
  static void handle_quadrature_interrupt();
  
  void initialize_rotary_encoder() {
-     cowpi_set_pullup_input_pins((1 << A_WIPER_PIN) | (1 << B_WIPER_PIN));
+     cowpi_set_pullup_input_pins(wiper_pins::mask);
      uint32_t quadrature = get_quadrature(); 
      direction = STATIONARY;
  
@@ -57,18 +68,19 @@
              break;
      }
  
-     register_pin_ISR((1 << A_WIPER_PIN) | (1 << B_WIPER_PIN), handle_quadrature_interrupt);
+     register_pin_ISR(wiper_pins::mask, handle_quadrature_interrupt);
  }
  
  uint8_t get_quadrature() {
-     ioport = (cowpi_ioport_t *)(0xD0000000);
- 
-     uint32_t quadrature = ioport->input & (0b11 << 16);
-     return (quadrature >> 16);
+     return (uint8_t) wiper_pins::read();
  }
  
  char *count_rotations(char *buffer) {
-     sprintf(buffer, "CW:%d CCW:%d", clockwise_count, counterclockwise_count);
+     uint32_t primask = disable_interrupts();
+     int clockwise = clockwise_count;
+     int counterclockwise = counterclockwise_count;
+     restore_interrupts(primask);
+     sprintf(buffer, "CW:%d CCW:%d", clockwise, counterclockwise);
      return buffer;
  }
  
@@ -78,6 +90,20 @@
      return result;
  }
  
+ int take_detent_delta() {
+     uint32_t primask = disable_interrupts();
+     int detents = detent_delta;
+     detent_delta = 0;
+     restore_interrupts(primask);
+     journal_detent_delta(detents);
+     emit_detent_telemetry(detents);
+     return detents;
+ }
+ 
+ void inject_detent_delta(int detents) {
+     detent_delta += detents;
+ }
+ 
  static void handle_quadrature_interrupt() {
      static rotation_state_t last_state = UNKNOWN;
      rotation_state_t previous_state = state;
@@ -96,11 +122,15 @@
          case 0b00:
              if ((previous_state == HIGH_LOW && last_state == HIGH_HIGH)) {
                  clockwise_count++;
+                 detent_delta++;
                  direction = CLOCKWISE;
+                 post_work(WORK_DETENT);
                  state = LOW_LOW;
              } else if ((previous_state == LOW_HIGH && last_state == HIGH_HIGH)) {
                  counterclockwise_count++;
+                 detent_delta--;
                  direction = COUNTERCLOCKWISE;
+                 post_work(WORK_DETENT);
                  state = LOW_LOW;
              }
              break;
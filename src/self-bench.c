@@ -0,0 +1,181 @@
+/**************************************************************************//**
+ *
+ * @file self-bench.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code for the on-device performance self-test.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "combination-engine.h"
+#include "deadline-monitor.h"
+#include "detent-delta.h"
+#include "display.h"
+#include "lock-controller.h"
+#include "registers.h"
+#include "rotary-encoder.h"
+#include "self-bench.h"
+#include "servo-interrupt.h"
+
+#ifdef COMBOLOCK_HOST
+#include "host-hal.h"
+#endif
+
+#define A_WIPER_PIN             (16)
+#define DISPLAY_REFRESHES       (8)
+#define FORMATTING_REPETITIONS  (1000)
+#define EDGES                   (1000)      // even, so that the wiper ends where it started
+#define SERVO_BATCHES           (10)
+#define SERVO_BATCH_SIZE        (100)       // keeps each stretch with interrupts masked short
+#define LOOP_WINDOW_US          (1000000)
+
+static self_bench_results_t results;
+static bool has_run = false;
+
+/*
+ * A software-triggered edge on the A wiper. On the RP2040 this flips the
+ * pad's input override between normal and inverted, which the GPIO edge
+ * detector sees as a real edge without anything driving the pin.
+ */
+#ifdef __MBED__
+#define INOVER_INVERT           (1 << 16)
+
+static uint32_t volatile *const a_wiper_control = (uint32_t *) (IO_BANK0_BASE + REGISTER_XOR_ALIAS + 8 * A_WIPER_PIN + 4);
+
+static inline void trigger_quadrature_edge(void) {
+    *a_wiper_control = INOVER_INVERT;
+}
+#else
+static inline void trigger_quadrature_edge(void) {
+    toggle_host_pin(A_WIPER_PIN);
+}
+#endif //__MBED__
+
+static uint32_t ns_per(uint32_t elapsed_us, uint32_t repetitions) {
+    return (uint32_t) ((uint64_t) elapsed_us * 1000 / repetitions);
+}
+
+static uint32_t time_display_refresh(void) {
+    uint32_t start = micros();
+    for (int i = 0; i < DISPLAY_REFRESHES; i++) {
+        refresh_display();
+    }
+    return (micros() - start) / DISPLAY_REFRESHES;
+}
+
+/* The same formatting that test mode does each iteration. */
+static uint32_t time_formatting(void) {
+    static char rotations_buffer[22];
+    static char combo_buffer[32];
+    uint32_t start = micros();
+    for (int i = 0; i < FORMATTING_REPETITIONS; i++) {
+        count_rotations(rotations_buffer);
+        uint8_t const *combination = get_combination();
+        strcpy(combo_buffer, "Combo:");
+        for (int j = 0; j < COMBINATION_LENGTH; j++) {
+            sprintf(combo_buffer + strlen(combo_buffer), (j == 0) ? " %02d" : "-%02d", combination[j]);
+        }
+    }
+    return ns_per(micros() - start, FORMATTING_REPETITIONS);
+}
+
+/* Edges with the ISR running, less the same edges with interrupts masked. */
+static uint32_t time_quadrature_isr(void) {
+    noInterrupts();
+    uint32_t start = micros();
+    for (int i = 0; i < EDGES; i++) {
+        trigger_quadrature_edge();
+    }
+    uint32_t masked = micros() - start;
+    interrupts();
+    start = micros();
+    for (int i = 0; i < EDGES; i++) {
+        trigger_quadrature_edge();
+    }
+    uint32_t unmasked = micros() - start;
+    take_detent_delta();    // discard anything the edges looked like
+    return (unmasked > masked) ? ns_per(unmasked - masked, EDGES) : 0;
+}
+
+static uint32_t time_servo_isr(void) {
+    uint32_t elapsed = 0;
+    for (int batch = 0; batch < SERVO_BATCHES; batch++) {
+        noInterrupts();
+        uint32_t start = micros();
+        for (int i = 0; i < SERVO_BATCH_SIZE; i++) {
+            run_servo_interrupt();
+        }
+        elapsed += micros() - start;
+        interrupts();
+    }
+    return ns_per(elapsed, SERVO_BATCHES * SERVO_BATCH_SIZE);
+}
+
+static uint32_t time_loop_rate(void (*iteration)(void)) {
+    uint32_t iterations = 0;
+    uint32_t start = micros();
+    uint32_t elapsed;
+    do {
+        iteration();
+        kick_watchdog();
+        iterations++;
+        elapsed = micros() - start;
+    } while (elapsed < LOOP_WINDOW_US);
+    return (uint32_t) ((uint64_t) iterations * 1000000 / elapsed);
+}
+
+static void report(int first_row) {
+    char buffer[32];
+    printf("self-bench:\n");
+    printf("  display refresh  %8lu us\n", (unsigned long) results.display_refresh_us);
+    printf("  formatting       %8lu ns\n", (unsigned long) results.formatting_ns);
+    printf("  quadrature ISR   %8lu ns\n", (unsigned long) results.quadrature_isr_ns);
+    printf("  servo ISR        %8lu ns\n", (unsigned long) results.servo_isr_ns);
+    printf("  loop rate        %8lu /s\n", (unsigned long) results.loops_per_second);
+    if (first_row < 0) {
+        return;
+    }
+    sprintf(buffer, "Refresh %7lu us", (unsigned long) results.display_refresh_us);
+    display_string(first_row, buffer);
+    sprintf(buffer, "Format  %7lu ns", (unsigned long) results.formatting_ns);
+    display_string(first_row + 1, buffer);
+    sprintf(buffer, "Quad    %7lu ns", (unsigned long) results.quadrature_isr_ns);
+    display_string(first_row + 2, buffer);
+    sprintf(buffer, "Servo   %7lu ns", (unsigned long) results.servo_isr_ns);
+    display_string(first_row + 3, buffer);
+    sprintf(buffer, "Loops   %7lu /s", (unsigned long) results.loops_per_second);
+    display_string(first_row + 4, buffer);
+}
+
+self_bench_results_t const *run_self_bench(void (*iteration)(void), int first_row) {
+#ifdef COMBOLOCK_HOST
+    // virtual time stands still while the kernels run, so the loop-rate window would never end
+    if (host_time_is_virtual()) {
+        printf("self-bench: needs real time\n");
+        return get_self_bench_results();
+    }
+#endif
+    results.display_refresh_us = time_display_refresh();
+    kick_watchdog();
+    results.formatting_ns = time_formatting();
+    results.quadrature_isr_ns = time_quadrature_isr();
+    results.servo_isr_ns = time_servo_isr();
+    kick_watchdog();
+    results.loops_per_second = time_loop_rate(iteration);
+    has_run = true;
+    report(first_row);
+    start_loop_iteration();     // the bench is not the loop's doing
+    return &results;
+}
+
+self_bench_results_t const *get_self_bench_results(void) {
+    return has_run ? &results : NULL;
+}
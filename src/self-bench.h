@@ -0,0 +1,63 @@
+/**************************************************************************//**
+ *
+ * @file self-bench.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Timed micro-benchmarks of the firmware's hot paths, run on the unit
+ *      itself from test mode: press # on the keypad to run them, and * to
+ *      return to the test display.
+ *
+ * The kernels are the same on the host, where the native build's
+ * <code>-b</code> option runs them.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_SELF_BENCH_H
+#define COMBOLOCK_SELF_BENCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t display_refresh_us;    // one full refresh_display()
+    uint32_t formatting_ns;         // formatting test mode's three rows
+    uint32_t quadrature_isr_ns;     // one wiper edge: interrupt entry, dispatch and handler
+    uint32_t servo_isr_ns;          // one servo timer ISR body
+    uint32_t loops_per_second;      // back-to-back `iteration` calls
+} self_bench_results_t;
+
+/**
+ * Runs each kernel, prints the results over Serial and leaves them on the
+ * display. This takes a little over a second, during which the watchdog is
+ * kept fed.
+ *
+ * @param iteration One main-loop iteration, for measuring the loop rate
+ * @param first_row The first of five display rows for the report, or -1 to
+ *      leave the display alone
+ * @return The results; on the host's virtual time, where nothing can be
+ *      timed, the bench does not run and the previous results, if any, are
+ *      returned
+ */
+self_bench_results_t const *run_self_bench(void (*iteration)(void), int first_row);
+
+/**
+ * @return The most recent results, or <code>NULL</code> if the bench has not
+ *      run
+ */
+self_bench_results_t const *get_self_bench_results(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_SELF_BENCH_H
@@ -0,0 +1,34 @@
+/**************************************************************************//**
+ *
+ * @file servo-interrupt.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A way to run the servo's timer ISR on demand, for the benches.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_SERVO_INTERRUPT_H
+#define COMBOLOCK_SERVO_INTERRUPT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Runs the servo's timer ISR once, with its pulse schedule and output pin put
+ * back afterward so that the signal is undisturbed; for timing the ISR.
+ */
+void run_servo_interrupt(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_SERVO_INTERRUPT_H
@@ -1,6 +1,6 @@
 /**************************************************************************//**
  *
- * @file rotary-encoder.c
+ * @file servomotor.cpp
  *
  * @author Nick Goertzen
  * @author Nolan Hill
@@ -15,8 +15,15 @@
  */
 
 #include <CowPi.h>
+
+extern "C" {
 #include "servomotor.h"
+}
+
 #include "interrupt_support.h"
+#include "registers.hpp"
+#include "servo-interrupt.h"
+#include "telemetry.h"
 
 #define SERVO_PIN           (22)
 #define PULSE_INCREMENT_uS  (500)
@@ -25,12 +32,13 @@
 static int volatile pulse_width_us;
 static int32_t next_rising_edge = 0;
 static int32_t next_falling_edge = 0;
-volatile cowpi_ioport_t *ioport = (cowpi_ioport_t *)(0xD0000000);
+
+typedef combolock::registers::gpio_pin<SERVO_PIN> servo_pin;
 
 static void handle_timer_interrupt();
 
 void initialize_servo() {
-    cowpi_set_output_pins(1 << SERVO_PIN);
+    cowpi_set_output_pins(servo_pin::mask);
     center_servo();
     register_periodic_timer_ISR(0, PULSE_INCREMENT_uS, handle_timer_interrupt);
 }
@@ -49,27 +57,44 @@ char *test_servo(char *buffer) {
     return buffer;
 }
 
+static void set_pulse_width(int width_us) {
+    if (pulse_width_us != width_us) {
+        pulse_width_us = width_us;
+        emit_servo_telemetry((uint16_t) width_us);
+    }
+}
+
 void center_servo() {
-    pulse_width_us = 1500;
+    set_pulse_width(1500);
 }
 
 void rotate_full_clockwise() {
-    pulse_width_us = 500;
+    set_pulse_width(500);
 }
 
 void rotate_full_counterclockwise() {
-    pulse_width_us = 2500;
+    set_pulse_width(2500);
+}
+
+void run_servo_interrupt(void) {
+    int32_t rising_edge = next_rising_edge;
+    int32_t falling_edge = next_falling_edge;
+    bool output = servo_pin::is_driven_high();
+    handle_timer_interrupt();
+    next_rising_edge = rising_edge;
+    next_falling_edge = falling_edge;
+    servo_pin::write(output);
 }
 
 static void handle_timer_interrupt() {
     next_rising_edge -= PULSE_INCREMENT_uS;
     next_falling_edge -= PULSE_INCREMENT_uS;
     if (next_rising_edge <= 0) {
-        ioport->output |= 1 << 22;
+        servo_pin::set();
         next_rising_edge = SIGNAL_PERIOD_uS;
         next_falling_edge = pulse_width_us;
     }
     if (next_falling_edge <= 0) {
-        ioport->output &= ~(1 << 22);
+        servo_pin::clear();
     }
 }
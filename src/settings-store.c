@@ -0,0 +1,329 @@
+/**************************************************************************//**
+ *
+ * @file settings-store.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to keep settings in a wear-levelled log in flash memory.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <stddef.h>
+#include "settings-store.h"
+
+#define RECORD_SIZE         (16)
+#define MAXIMUM_PAGE_SIZE   (256)
+#define ERASED_KEY          (0xFF)
+#define HEADER_KEY          (0xFE)
+#define COMMIT_KEY          (0xFD)
+#define CACHE_MAGIC         (0x5E771065)
+
+typedef struct {
+    uint8_t key;
+    uint8_t length;
+    uint16_t crc;
+    uint32_t sequence;          // the sector's epoch for header and commit records
+    uint8_t value[SETTING_VALUE_SIZE];
+} record_t;
+
+typedef enum {
+    STORE_APPENDING, STORE_ERASING, STORE_WRITING_HEADER, STORE_COPYING
+} store_phase_t;
+
+/* Everything needed to mount without touching more than two flash records.
+ * It survives a soft reset; after a power cycle the CRC will not match. */
+typedef struct {
+    uint32_t magic;
+    uint32_t active_sector;
+    uint32_t next_slot;
+    uint32_t epoch;
+    uint32_t sequence;
+    uint32_t last_sequence;
+    uint16_t present;
+    uint16_t dirty;
+    uint8_t lengths[NUMBER_OF_SETTINGS];
+    uint8_t values[NUMBER_OF_SETTINGS][SETTING_VALUE_SIZE];
+    uint16_t crc;
+} store_cache_t;
+
+static store_cache_t cache __attribute__((section (".uninitialized_ram.")));
+
+static flash_device_t const *flash;
+static uint32_t slots_per_sector;
+static store_phase_t phase;
+static uint32_t target_sector;
+static uint32_t copy_slot;
+static uint8_t copy_key;
+static uint8_t page[MAXIMUM_PAGE_SIZE];
+
+static uint16_t crc16(void const *data, uint32_t length, uint16_t crc) {
+    uint8_t const *bytes = (uint8_t const *) data;
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= (uint16_t) (bytes[i] << 8);
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t record_crc(record_t const *record) {
+    uint16_t crc = crc16(record, 2, 0xFFFF);
+    return crc16(&record->sequence, RECORD_SIZE - 4, crc);
+}
+
+static uint16_t cache_crc(void) {
+    return crc16(&cache, offsetof(store_cache_t, crc), 0xFFFF);
+}
+
+static void save_cache(void) {
+    cache.magic = CACHE_MAGIC;
+    cache.crc = cache_crc();
+}
+
+static uint32_t slot_offset(uint32_t sector, uint32_t slot) {
+    return sector * flash->sector_size + slot * RECORD_SIZE;
+}
+
+static bool read_record(uint32_t sector, uint32_t slot, record_t *record) {
+    return flash->read(slot_offset(sector, slot), record, RECORD_SIZE) == 0;
+}
+
+static bool record_is_valid(record_t const *record) {
+    return record->key != ERASED_KEY && record->crc == record_crc(record);
+}
+
+static bool record_is_erased(record_t const *record) {
+    uint8_t const *bytes = (uint8_t const *) record;
+    for (int i = 0; i < RECORD_SIZE; i++) {
+        if (bytes[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Programs one record into its slot of the given sector. The rest of the page
+ * is left erased, which NOR flash permits to be programmed again later. */
+static bool program_record(uint32_t sector, uint32_t slot, uint8_t key, uint8_t length, uint32_t sequence,
+                           uint8_t const *value) {
+    record_t record;
+    memset(&record, 0xFF, sizeof(record));
+    record.key = key;
+    record.length = length;
+    record.sequence = sequence;
+    if (length) {
+        memcpy(record.value, value, length);
+    }
+    record.crc = record_crc(&record);
+    uint32_t offset = slot_offset(sector, slot);
+    uint32_t page_offset = offset - offset % flash->page_size;
+    memset(page, 0xFF, flash->page_size);
+    memcpy(page + (offset - page_offset), &record, RECORD_SIZE);
+    return flash->program(page_offset, page) == 0;
+}
+
+static bool mount_from_cache(void) {
+    if (cache.magic != CACHE_MAGIC || cache.crc != cache_crc()) {
+        return false;
+    }
+    if (cache.active_sector >= flash->number_of_sectors || cache.next_slot == 0
+        || cache.next_slot > slots_per_sector) {
+        return false;
+    }
+    record_t record;
+    if (!read_record(cache.active_sector, cache.next_slot - 1, &record)
+        || !record_is_valid(&record) || record.sequence != cache.last_sequence) {
+        return false;
+    }
+    if (cache.next_slot < slots_per_sector) {
+        if (!read_record(cache.active_sector, cache.next_slot, &record) || !record_is_erased(&record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Replays one sector into the cache. Returns false if the sector's snapshot
+ * was never committed, in which case the cache contents are meaningless. */
+static bool mount_sector(uint32_t sector, uint32_t epoch) {
+    record_t record;
+    bool committed = false;
+    uint32_t slot = 1;
+    cache.present = 0;
+    cache.dirty = 0;
+    cache.sequence = 0;
+    cache.last_sequence = epoch;
+    while (slot < slots_per_sector && read_record(sector, slot, &record) && !record_is_erased(&record)) {
+        slot++;
+        if (!record_is_valid(&record)) {
+            continue;               // torn by a power cut; the slot stays consumed
+        }
+        cache.last_sequence = record.sequence;
+        if (record.key == COMMIT_KEY) {
+            committed = true;
+        } else if (record.key < NUMBER_OF_SETTINGS && record.length <= SETTING_VALUE_SIZE) {
+            cache.present |= 1 << record.key;
+            cache.lengths[record.key] = record.length;
+            memcpy(cache.values[record.key], record.value, record.length);
+            if (record.sequence > cache.sequence) {
+                cache.sequence = record.sequence;
+            }
+        }
+    }
+    cache.active_sector = sector;
+    cache.next_slot = slot;
+    cache.epoch = epoch;
+    return committed;
+}
+
+static bool mount_by_scanning(void) {
+    uint32_t tried_epoch = UINT32_MAX;
+    // try sectors newest-first; each attempt reads one header per sector
+    while (true) {
+        bool found = false;
+        uint32_t best_sector = 0;
+        uint32_t best_epoch = 0;
+        for (uint32_t sector = 0; sector < flash->number_of_sectors; sector++) {
+            record_t header;
+            if (read_record(sector, 0, &header) && record_is_valid(&header) && header.key == HEADER_KEY
+                && header.sequence < tried_epoch && (!found || header.sequence > best_epoch)) {
+                found = true;
+                best_sector = sector;
+                best_epoch = header.sequence;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+        if (mount_sector(best_sector, best_epoch)) {
+            return true;
+        }
+        tried_epoch = best_epoch;
+    }
+}
+
+static void begin_compaction(void) {
+    target_sector = (cache.active_sector + 1) % flash->number_of_sectors;
+    phase = STORE_ERASING;
+}
+
+bool initialize_settings_store(flash_device_t const *device) {
+    flash = device;
+    slots_per_sector = flash->sector_size / RECORD_SIZE;
+    phase = STORE_APPENDING;
+    if (mount_from_cache()) {
+        return true;
+    }
+    if (!mount_by_scanning()) {
+        // nothing usable: pretend the last sector is full so the first write formats sector 0
+        memset(&cache, 0, sizeof(cache));
+        cache.active_sector = flash->number_of_sectors - 1;
+        cache.next_slot = slots_per_sector;
+    }
+    save_cache();
+    return false;
+}
+
+int read_setting(uint8_t key, void *value, int capacity) {
+    if (key >= NUMBER_OF_SETTINGS || !(cache.present & (1 << key))) {
+        return -1;
+    }
+    int length = cache.lengths[key];
+    memcpy(value, cache.values[key], (length < capacity) ? length : capacity);
+    return length;
+}
+
+void write_setting(uint8_t key, void const *value, int length) {
+    if (key >= NUMBER_OF_SETTINGS || length < 0 || length > SETTING_VALUE_SIZE) {
+        return;
+    }
+    if ((cache.present & (1 << key)) && cache.lengths[key] == length
+        && !memcmp(cache.values[key], value, length)) {
+        return;
+    }
+    cache.present |= 1 << key;
+    cache.lengths[key] = (uint8_t) length;
+    memcpy(cache.values[key], value, length);
+    cache.dirty |= 1 << key;
+    save_cache();
+}
+
+bool service_settings_store(void) {
+    if (flash == NULL) {
+        return false;
+    }
+    switch (phase) {
+        case STORE_APPENDING:
+            if (!cache.dirty) {
+                return false;
+            }
+            if (cache.next_slot >= slots_per_sector) {
+                begin_compaction();
+            } else {
+                uint8_t key = 0;
+                while (!(cache.dirty & (1 << key))) {
+                    key++;
+                }
+                uint32_t slot = cache.next_slot++;
+                if (program_record(cache.active_sector, slot, key, cache.lengths[key], cache.sequence + 1,
+                                   cache.values[key])) {
+                    cache.sequence++;
+                    cache.last_sequence = cache.sequence;
+                    cache.dirty &= ~(1 << key);
+                }
+            }
+            break;
+        case STORE_ERASING:
+            if (flash->erase(target_sector * flash->sector_size) == 0) {
+                phase = STORE_WRITING_HEADER;
+            }
+            break;
+        case STORE_WRITING_HEADER:
+            if (program_record(target_sector, 0, HEADER_KEY, 0, cache.epoch + 1, NULL)) {
+                phase = STORE_COPYING;
+                copy_slot = 1;
+                copy_key = 0;
+            } else {
+                phase = STORE_ERASING;
+            }
+            break;
+        case STORE_COPYING:
+            while (copy_key < NUMBER_OF_SETTINGS && !(cache.present & (1 << copy_key))) {
+                copy_key++;
+            }
+            if (copy_slot >= slots_per_sector) {
+                phase = STORE_ERASING;  // too many torn slots to fit the snapshot; start over
+            } else if (copy_key < NUMBER_OF_SETTINGS) {
+                if (program_record(target_sector, copy_slot, copy_key, cache.lengths[copy_key],
+                                   cache.sequence + 1, cache.values[copy_key])) {
+                    cache.sequence++;
+                    cache.dirty &= ~(1 << copy_key);
+                    copy_key++;
+                }
+                copy_slot++;
+            } else if (program_record(target_sector, copy_slot, COMMIT_KEY, 0, cache.epoch + 1, NULL)) {
+                cache.active_sector = target_sector;
+                cache.next_slot = copy_slot + 1;
+                cache.epoch++;
+                cache.last_sequence = cache.epoch;
+                phase = STORE_APPENDING;
+            } else {
+                phase = STORE_ERASING;
+            }
+            break;
+    }
+    save_cache();
+    return cache.dirty || phase != STORE_APPENDING;
+}
+
+void discard_settings_store_cache(void) {
+    cache.magic = 0;
+}
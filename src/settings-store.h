@@ -0,0 +1,113 @@
+/**************************************************************************//**
+ *
+ * @file settings-store.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A log-structured, wear-levelled settings store kept in a reserved
+ *      region of flash memory.
+ *
+ * Every change is appended as a small CRC-protected record. The region is
+ * divided into sectors that are used round-robin; when the active sector
+ * fills, the live settings are copied forward into the next sector, so the
+ * newest committed sector always holds a complete snapshot. Mounting after a
+ * soft reset is O(1) using a tail pointer cached in uninitialized RAM; after a
+ * power cycle only the newest sector is scanned, so boot time does not grow
+ * with the age of the log.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_SETTINGS_STORE_H
+#define COMBOLOCK_SETTINGS_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SETTING_VALUE_SIZE  (8)
+#define NUMBER_OF_SETTINGS  (8)
+
+typedef enum {
+    SETTING_COMBINATION = 0,
+    SETTING_BAD_TRIES = 1,
+} setting_key_t;
+
+/**
+ * The flash operations that the settings store needs. Offsets are relative to
+ * the start of the reserved region. Each function returns 0 on success.
+ * `program` writes exactly one page at a page-aligned offset and may only
+ * clear bits; `erase` sets one sector to 0xFF.
+ */
+typedef struct {
+    uint32_t page_size;
+    uint32_t sector_size;
+    uint32_t number_of_sectors;
+    int (*read)(uint32_t offset, void *buffer, uint32_t length);
+    int (*program)(uint32_t offset, void const *page);
+    int (*erase)(uint32_t offset);
+} flash_device_t;
+
+/**
+ * @return The flash device backing the settings store on this platform
+ */
+flash_device_t const *get_flash_device(void);
+
+/**
+ * Mounts the settings store.
+ *
+ * @param device The flash device holding the log
+ * @return <code>true</code> if the store was mounted from the cached tail
+ *      pointer; <code>false</code> if the newest sector had to be scanned or
+ *      the region had to be formatted
+ */
+bool initialize_settings_store(flash_device_t const *device);
+
+/**
+ * Copies the most recent value of a setting into `value`.
+ *
+ * @param key The setting to read
+ * @param value The buffer to receive the value
+ * @param capacity The size of the buffer
+ * @return The length of the value, or -1 if the setting has never been written
+ */
+int read_setting(uint8_t key, void *value, int capacity);
+
+/**
+ * Updates a setting. The new value is visible to read_setting() immediately;
+ * it reaches flash over subsequent calls to service_settings_store().
+ *
+ * @param key The setting to write
+ * @param value The new value
+ * @param length The length of the value, no more than SETTING_VALUE_SIZE
+ */
+void write_setting(uint8_t key, void const *value, int length);
+
+/**
+ * Performs at most one flash operation (a page program or, once per sector's
+ * worth of records, a sector erase) toward persisting outstanding writes.
+ * Call this from the main loop.
+ *
+ * @return <code>true</code> if more work remains; <code>false</code> otherwise
+ */
+bool service_settings_store(void);
+
+/**
+ * Invalidates the tail pointer cached in uninitialized RAM, as a power cycle
+ * would, so that the next mount scans flash.
+ */
+void discard_settings_store_cache(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_SETTINGS_STORE_H
@@ -0,0 +1,132 @@
+/**************************************************************************//**
+ *
+ * @file stack-monitor.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to paint the stacks and find their high-water marks.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "critical-section.h"
+#include "flight-recorder.h"
+#include "stack-monitor.h"
+
+#ifdef __MBED__
+#include <rtx_os.h>
+#else
+#include <alloca.h>
+#endif
+
+typedef struct {
+    uint32_t *bottom;           // stacks grow down, toward here
+    uint32_t *top;
+    stack_usage_t usage;
+} monitored_stack_t;
+
+static char const *stack_names[NUMBER_OF_STACKS] = {"main", "interrupt"};
+static monitored_stack_t stacks[NUMBER_OF_STACKS];
+
+void paint_stack(uint32_t *bottom, uint32_t *end) {
+    for (uint32_t volatile *word = bottom; word < end; word++) {
+        *word = STACK_PAINT;
+    }
+}
+
+uint32_t count_painted_words(uint32_t const *bottom, uint32_t const *top) {
+    uint32_t const *word = bottom;
+    while (word < top && *word == STACK_PAINT) {
+        word++;
+    }
+    return (uint32_t) (word - bottom);
+}
+
+#ifdef __MBED__
+
+extern uint32_t __StackBottom[];
+extern uint32_t __StackTop[];
+
+static inline uint32_t *get_stack_pointer(void) {
+    uint32_t *sp;
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    return sp;
+}
+
+static inline uint32_t *get_main_stack_pointer(void) {
+    uint32_t *msp;
+    __asm volatile ("mrs %0, msp" : "=r" (msp));
+    return msp;
+}
+
+/* Thread mode runs on PSP and interrupts on MSP, so nothing else writes below
+ * either pointer while interrupts are off. */
+static void paint_stacks(void) {
+    osRtxThread_t const *thread = (osRtxThread_t const *) osThreadGetId();
+    stacks[STACK_MAIN].bottom = (uint32_t *) thread->stack_mem;
+    stacks[STACK_MAIN].top = (uint32_t *) ((uint8_t *) thread->stack_mem + thread->stack_size);
+    stacks[STACK_INTERRUPT].bottom = __StackBottom;
+    stacks[STACK_INTERRUPT].top = __StackTop;
+    uint32_t primask = disable_interrupts();
+    paint_stack(stacks[STACK_MAIN].bottom, get_stack_pointer());
+    paint_stack(stacks[STACK_INTERRUPT].bottom, get_main_stack_pointer());
+    restore_interrupts(primask);
+}
+
+#else
+
+/* The block that alloca() hands out is the stack that setup()'s callees, and
+ * loop() and its callees, will use once this returns. */
+static void __attribute__((noinline)) paint_stacks(void) {
+    uint32_t *block = alloca(STACK_HOST_DEPTH);
+    stacks[STACK_MAIN].bottom = block;
+    stacks[STACK_MAIN].top = block + STACK_HOST_DEPTH / sizeof(uint32_t);
+    paint_stack(block, stacks[STACK_MAIN].top);
+}
+
+#endif //__MBED__
+
+void initialize_stack_monitor(void) {
+    memset(stacks, 0, sizeof(stacks));
+    paint_stacks();
+    for (int i = 0; i < NUMBER_OF_STACKS; i++) {
+        stacks[i].usage.size_bytes = (uint32_t) ((uint8_t *) stacks[i].top - (uint8_t *) stacks[i].bottom);
+    }
+}
+
+void scan_stacks(void) {
+    for (int i = 0; i < NUMBER_OF_STACKS; i++) {
+        monitored_stack_t *stack = &stacks[i];
+        if (stack->usage.size_bytes == 0) {
+            continue;
+        }
+        uint32_t used = stack->usage.size_bytes
+                        - sizeof(uint32_t) * count_painted_words(stack->bottom, stack->top);
+        if (used > stack->usage.high_water_bytes) {
+            stack->usage.high_water_bytes = used;
+            printf("%s stack: %lu of %lu bytes used\n", stack_names[i], (unsigned long) used,
+                   (unsigned long) stack->usage.size_bytes);
+        }
+        if (COMBOLOCK_STACK_GUARD_WORDS > 0 && !stack->usage.overflowed
+            && used > stack->usage.size_bytes - sizeof(uint32_t) * COMBOLOCK_STACK_GUARD_WORDS) {
+            stack->usage.overflowed = true;
+            record_flight_event(FLIGHT_STACK_OVERFLOW, (uint8_t) i,
+                                (uint16_t) ((used > UINT16_MAX) ? UINT16_MAX : used));
+            printf("%s stack overflowed into its guard region\n", stack_names[i]);
+        }
+    }
+}
+
+stack_usage_t get_stack_usage(stack_id_t stack) {
+    return stacks[stack].usage;
+}
+
+char const *get_stack_name(stack_id_t stack) {
+    return (stack < NUMBER_OF_STACKS) ? stack_names[stack] : "?";
+}
@@ -0,0 +1,93 @@
+/**************************************************************************//**
+ *
+ * @file stack-monitor.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief High-water marks for the main stack and the interrupt stack, found
+ *      by painting the stacks at boot and scanning for the paint later.
+ *
+ * initialize_stack_monitor() fills the unused part of each stack with
+ * STACK_PAINT. scan_stacks() then counts, from the far end of each stack, the
+ * words that still hold the paint: the rest of the stack has been used at
+ * some point, which is the high-water mark. A scan costs one load per unused
+ * word, so it is cheap enough to run every STACK_SCAN_PERIOD_MS.
+ *
+ * The lowest COMBOLOCK_STACK_GUARD_WORDS words of each stack are a guard
+ * region. If a scan finds the paint there disturbed, the stack has
+ * overflowed, or nearly so; the scan records a FLIGHT_STACK_OVERFLOW event,
+ * which survives the reset that is likely to follow. Build with
+ * <code>-DCOMBOLOCK_STACK_GUARD_WORDS=0</code> to skip the check.
+ *
+ * On the RP2040, the main stack is the MBED main thread's stack, where
+ * setup() and loop() run, and the interrupt stack is the one that MSP points
+ * into. On the host, interrupts run on the main stack, and the main stack is
+ * the STACK_HOST_DEPTH bytes below setup()'s caller.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_STACK_MONITOR_H
+#define COMBOLOCK_STACK_MONITOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STACK_PAINT             (0x5EA1ED5Au)
+#define STACK_SCAN_PERIOD_MS    (1000)
+#define STACK_HOST_DEPTH        (65536)
+
+#ifndef COMBOLOCK_STACK_GUARD_WORDS
+#define COMBOLOCK_STACK_GUARD_WORDS     (8)
+#endif
+
+typedef enum {
+    STACK_MAIN, STACK_INTERRUPT, NUMBER_OF_STACKS
+} stack_id_t;
+
+typedef struct {
+    uint32_t size_bytes;        // 0 if this stack is not monitored
+    uint32_t high_water_bytes;
+    bool overflowed;            // the guard region was disturbed
+} stack_usage_t;
+
+/**
+ * Paints the unused part of each stack. Call first thing in setup().
+ */
+void initialize_stack_monitor(void);
+
+/**
+ * Updates the high-water marks, printing any that rose, and checks the guard
+ * regions.
+ */
+void scan_stacks(void);
+
+stack_usage_t get_stack_usage(stack_id_t stack);
+
+char const *get_stack_name(stack_id_t stack);
+
+/**
+ * Fills [bottom, end) with STACK_PAINT.
+ */
+void paint_stack(uint32_t *bottom, uint32_t *end);
+
+/**
+ * @return The number of words from `bottom` up that still hold STACK_PAINT,
+ *      stopping at `top`
+ */
+uint32_t count_painted_words(uint32_t const *bottom, uint32_t const *top);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_STACK_MONITOR_H
@@ -0,0 +1,75 @@
+/**************************************************************************//**
+ *
+ * @file task-scheduler.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to run loop()'s stackless tasks.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "deadline-monitor.h"
+#include "task-scheduler.h"
+
+static task_t tasks[MAXIMUM_NUMBER_OF_TASKS];
+static uint8_t number_of_tasks = 0;
+static uint32_t now;
+static scheduler_metrics_t metrics;
+
+void initialize_task_scheduler(void) {
+    memset(tasks, 0, sizeof(tasks));
+    number_of_tasks = 0;
+    memset(&metrics, 0, sizeof(metrics));
+}
+
+bool start_task(task_status_t (*body)(task_t *task), char const *name, uint8_t subsystem) {
+    if (number_of_tasks == MAXIMUM_NUMBER_OF_TASKS) {
+        return false;
+    }
+    task_t *task = &tasks[number_of_tasks++];
+    memset(task, 0, sizeof(*task));
+    task->body = body;
+    task->name = name;
+    task->subsystem = subsystem;
+    return true;
+}
+
+uint32_t run_tasks(uint32_t events, uint32_t now_us) {
+    now = now_us;
+    metrics.passes++;
+    int32_t earliest_us = INT32_MAX;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < number_of_tasks; i++) {
+        task_t *task = &tasks[i];
+        task->events |= events;
+        task_status_t status = task->body(task);
+        metrics.resumptions++;
+        end_subsystem((loop_subsystem_t) task->subsystem);
+        if (status != TASK_ENDED) {
+            if (task->wake_is_set && (int32_t) (task->wake_us - now_us) < earliest_us) {
+                earliest_us = (int32_t) (task->wake_us - now_us);
+            }
+            if (kept != i) {
+                tasks[kept] = *task;
+            }
+            kept++;
+        }
+    }
+    number_of_tasks = kept;
+    return now_us + (uint32_t) earliest_us;
+}
+
+uint32_t get_task_time(void) {
+    return now;
+}
+
+scheduler_metrics_t get_scheduler_metrics(void) {
+    return metrics;
+}
@@ -0,0 +1,148 @@
+/**************************************************************************//**
+ *
+ * @file task-scheduler.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A cooperative scheduler for loop(): each activity is a stackless
+ *      task that runs until it has to wait for an event, a delay or a
+ *      condition, and then returns to the scheduler.
+ *
+ * A task is a function written between TASK_BEGIN() and TASK_END(). The
+ * TASK_AWAIT...() macros record where the task stopped and return; the next
+ * time the scheduler calls the function, TASK_BEGIN() jumps back to that
+ * point. Tasks share loop()'s stack, so a task's locals do not survive a
+ * wait: anything a task needs across a wait must be static. For the same
+ * reason, the waits must be in the task function itself, not in a function
+ * it calls, and must not be inside a <code>switch</code>.
+ *
+ * The events are the pending-work flags (pending-work.h) that the ISRs post.
+ * In the tickless build, loop() only runs when one is posted; run_tasks()
+ * returns the earliest time a waiting task's delay or timeout runs out, and
+ * loop() arms the wake-up alarm for it, so a delay ends on time even when no
+ * ISR posts anything. A task waiting on TASK_YIELD() or on a bare
+ * TASK_AWAIT() sets no time, and runs on whichever pass comes next.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_TASK_SCHEDULER_H
+#define COMBOLOCK_TASK_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MAXIMUM_NUMBER_OF_TASKS     (8)
+
+typedef enum {
+    TASK_WAITING, TASK_ENDED
+} task_status_t;
+
+typedef struct task task_t;
+
+struct task {
+    task_status_t (*body)(task_t *task);
+    char const *name;
+    uint32_t wake_us;           // when a delay or timeout runs out
+    bool wake_is_set;           // whether the task is waiting for wake_us
+    uint32_t events;            // events posted since the task last consumed them
+    uint16_t resume_point;      // the line of the wait the task stopped at, or 0 to start over
+    uint8_t subsystem;          // what the deadline monitor charges the task's time to
+};
+
+typedef struct {
+    uint32_t passes;            // calls to run_tasks()
+    uint32_t resumptions;       // task functions called
+} scheduler_metrics_t;
+
+#define TASK_BEGIN(task)        switch ((task)->resume_point) { case 0:
+
+#define TASK_END(task)          } (task)->resume_point = 0; return TASK_ENDED
+
+/** Returns to the scheduler until the next pass. */
+#define TASK_YIELD(task)                                                    \
+    do {                                                                    \
+        (task)->resume_point = __LINE__; return TASK_WAITING; case __LINE__:; \
+    } while (0)
+
+/** Returns to the scheduler on each pass until `condition` holds. */
+#define TASK_AWAIT(task, condition)                                         \
+    do {                                                                    \
+        (task)->resume_point = __LINE__; __attribute__((fallthrough));      \
+        case __LINE__:                                                      \
+        if (!(condition)) {                                                 \
+            return TASK_WAITING;                                            \
+        }                                                                   \
+    } while (0)
+
+/** Waits for `delay_us` microseconds. */
+#define TASK_DELAY(task, delay_us)                                          \
+    do {                                                                    \
+        (task)->wake_us = get_task_time() + (delay_us);                     \
+        (task)->wake_is_set = true;                                         \
+        TASK_AWAIT(task, task_time_has_come(task));                         \
+        (task)->wake_is_set = false;                                        \
+    } while (0)
+
+/**
+ * Waits for any of the events in `mask`, or for `timeout_us` microseconds,
+ * whichever comes first, and then consumes the task's events.
+ */
+#define TASK_AWAIT_EVENTS(task, mask, timeout_us)                           \
+    do {                                                                    \
+        (task)->wake_us = get_task_time() + (timeout_us);                   \
+        (task)->wake_is_set = true;                                         \
+        TASK_AWAIT(task, ((task)->events & (mask)) || task_time_has_come(task)); \
+        (task)->wake_is_set = false;                                        \
+        (task)->events = 0;                                                 \
+    } while (0)
+
+void initialize_task_scheduler(void);
+
+/**
+ * Adds a task, which first runs on the next pass.
+ *
+ * @param body The task function
+ * @param name The task's name, for reports
+ * @param subsystem The loop_subsystem_t that the task's time is charged to
+ * @return <code>false</code> if there are already MAXIMUM_NUMBER_OF_TASKS
+ *      tasks
+ */
+bool start_task(task_status_t (*body)(task_t *task), char const *name, uint8_t subsystem);
+
+/**
+ * Makes one pass over the tasks, in the order they were started, resuming
+ * each one; a task that has ended is removed.
+ *
+ * @param events The pending-work flags taken since the previous pass
+ * @param now_us The time that delays and timeouts are measured against
+ * @return The earliest time that a waiting task's delay or timeout runs
+ *      out; if no task is waiting for one, <code>now_us + INT32_MAX</code>
+ */
+uint32_t run_tasks(uint32_t events, uint32_t now_us);
+
+/**
+ * @return The time run_tasks() was given for the current pass
+ */
+uint32_t get_task_time(void);
+
+static inline bool task_time_has_come(task_t const *task) {
+    return (int32_t) (get_task_time() - task->wake_us) >= 0;
+}
+
+scheduler_metrics_t get_scheduler_metrics(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_TASK_SCHEDULER_H
@@ -0,0 +1,47 @@
+/**************************************************************************//**
+ *
+ * @file telemetry-serial.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The telemetry channel's view of the Serial port.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "telemetry.h"
+
+#ifdef __MBED__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int serial_available_for_write(void) {
+    return Serial.availableForWrite();
+}
+
+static void serial_write(uint8_t const *bytes, int length) {
+    Serial.write(bytes, length);
+}
+
+static telemetry_sink_t const serial_sink = {
+        .available_for_write = serial_available_for_write,
+        .write = serial_write,
+};
+
+telemetry_sink_t const *get_telemetry_sink(void) {
+    return &serial_sink;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //__MBED__
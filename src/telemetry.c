@@ -0,0 +1,227 @@
+/**************************************************************************//**
+ *
+ * @file telemetry.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to queue telemetry records and drain them as COBS frames.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "telemetry.h"
+#include "time-service.h"
+
+#define LOOP_REPORT_PERIOD_uS   (1000000)
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+    uint32_t timestamp_us;
+    uint8_t payload[TELEMETRY_MAXIMUM_PAYLOAD];
+} telemetry_record_t;
+
+static telemetry_sink_t const *sink = NULL;
+
+// records are emitted and drained from the main loop only
+static telemetry_record_t queue[TELEMETRY_QUEUE_LENGTH];
+static uint8_t queue_head = 0;
+static uint8_t queue_tail = 0;
+static uint8_t sequence = 0;
+static uint32_t unreported_drops = 0;
+static telemetry_metrics_t metrics;
+
+// the frame being sent, which may take several calls to service_telemetry()
+static uint8_t frame[TELEMETRY_MAXIMUM_FRAME];
+static int frame_length = 0;
+static int frame_sent = 0;
+
+static uint32_t loop_period_start;
+static uint32_t last_iteration_start;
+static uint32_t iterations = 0;
+static uint32_t longest_iteration_us = 0;
+
+static uint8_t crc8(uint8_t const *bytes, int length) {
+    uint8_t crc = 0;
+    for (int i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+        }
+    }
+    return crc;
+}
+
+static int cobs_encode(uint8_t const *input, int length, uint8_t *output) {
+    int code_index = 0;
+    int output_index = 1;
+    uint8_t code = 1;
+    for (int i = 0; i < length; i++) {
+        if (input[i] == 0) {
+            output[code_index] = code;
+            code_index = output_index++;
+            code = 1;
+        } else {
+            output[output_index++] = input[i];
+            if (++code == 0xFF) {
+                output[code_index] = code;
+                code_index = output_index++;
+                code = 1;
+            }
+        }
+    }
+    output[code_index] = code;
+    return output_index;
+}
+
+void initialize_telemetry(telemetry_sink_t const *telemetry_sink) {
+    sink = telemetry_sink;
+    queue_head = 0;
+    queue_tail = 0;
+    unreported_drops = 0;
+    memset(&metrics, 0, sizeof(metrics));
+    frame_length = 0;
+    frame_sent = 0;
+    iterations = 0;
+    longest_iteration_us = 0;
+}
+
+void emit_telemetry(telemetry_type_t type, void const *payload, uint8_t length) {
+    if (sink == NULL || length > TELEMETRY_MAXIMUM_PAYLOAD) {
+        return;
+    }
+    uint8_t head = queue_head;
+    uint8_t next_head = (head + 1) % TELEMETRY_QUEUE_LENGTH;
+    if (next_head == queue_tail) {
+        metrics.dropped_records++;
+        unreported_drops++;
+        return;
+    }
+    telemetry_record_t *record = &queue[head];
+    record->type = type;
+    record->length = length;
+    record->timestamp_us = (uint32_t) get_time_us();
+    memcpy(record->payload, payload, length);
+    queue_head = next_head;
+    metrics.records++;
+}
+
+void emit_detent_telemetry(int detents) {
+    if (detents != 0) {
+        unsigned count = (detents > 0) ? (unsigned) detents : (unsigned) -detents;
+        uint8_t payload[] = {(uint8_t) ((detents > 0) ? CLOCKWISE : COUNTERCLOCKWISE),
+                             (uint8_t) ((count < 0xFF) ? count : 0xFF)};
+        emit_telemetry(TELEMETRY_DETENT, payload, 2);
+    }
+}
+
+void emit_state_telemetry(uint8_t previous_state, uint8_t new_state) {
+    uint8_t payload[] = {previous_state, new_state};
+    emit_telemetry(TELEMETRY_STATE, payload, 2);
+}
+
+void emit_bad_tries_telemetry(uint8_t bad_tries) {
+    emit_telemetry(TELEMETRY_BAD_TRIES, &bad_tries, 1);
+}
+
+void emit_servo_telemetry(uint16_t pulse_width_us) {
+    uint8_t payload[] = {(uint8_t) (pulse_width_us & 0xFF), (uint8_t) (pulse_width_us >> 8)};
+    emit_telemetry(TELEMETRY_SERVO, payload, 2);
+}
+
+static void put_uint32(uint8_t *bytes, uint32_t value) {
+    bytes[0] = (uint8_t) value;
+    bytes[1] = (uint8_t) (value >> 8);
+    bytes[2] = (uint8_t) (value >> 16);
+    bytes[3] = (uint8_t) (value >> 24);
+}
+
+int encode_telemetry_frame(uint8_t encoded[TELEMETRY_MAXIMUM_FRAME]) {
+    telemetry_record_t dropped;
+    telemetry_record_t const *record;
+    if (unreported_drops) {
+        // report the loss as soon as there is room, ahead of whatever survived
+        dropped.type = TELEMETRY_DROPPED;
+        dropped.length = 4;
+        dropped.timestamp_us = (uint32_t) get_time_us();
+        put_uint32(dropped.payload, unreported_drops);
+        unreported_drops = 0;
+        record = &dropped;
+    } else if (queue_tail != queue_head) {
+        record = &queue[queue_tail];
+    } else {
+        return 0;
+    }
+    uint8_t raw[TELEMETRY_HEADER_SIZE + TELEMETRY_MAXIMUM_PAYLOAD + 1];
+    raw[0] = record->type;
+    raw[1] = sequence++;
+    put_uint32(raw + 2, record->timestamp_us);
+    memcpy(raw + TELEMETRY_HEADER_SIZE, record->payload, record->length);
+    int length = TELEMETRY_HEADER_SIZE + record->length;
+    raw[length] = crc8(raw, length);
+    if (record != &dropped) {
+        queue_tail = (queue_tail + 1) % TELEMETRY_QUEUE_LENGTH;
+    }
+    encoded[0] = 0;
+    int encoded_length = 1 + cobs_encode(raw, length + 1, encoded + 1);
+    encoded[encoded_length++] = 0;
+    return encoded_length;
+}
+
+static void time_loop_iteration(void) {
+    uint32_t now = (uint32_t) get_time_us();
+    if (iterations == 0) {
+        loop_period_start = now;
+    } else if (now - last_iteration_start > longest_iteration_us) {
+        longest_iteration_us = now - last_iteration_start;
+    }
+    last_iteration_start = now;
+    iterations++;
+    if (now - loop_period_start >= LOOP_REPORT_PERIOD_uS) {
+        uint8_t payload[8];
+        put_uint32(payload, iterations - 1);
+        put_uint32(payload + 4, longest_iteration_us);
+        emit_telemetry(TELEMETRY_LOOP, payload, 8);
+        loop_period_start = now;
+        longest_iteration_us = 0;
+        iterations = 1;
+    }
+}
+
+void service_telemetry(void) {
+    if (sink == NULL) {
+        return;
+    }
+    time_loop_iteration();
+    int space = sink->available_for_write();
+    while (space > 0) {
+        if (frame_sent == frame_length) {
+            frame_length = encode_telemetry_frame(frame);
+            frame_sent = 0;
+            if (frame_length == 0) {
+                break;
+            }
+        }
+        int chunk = frame_length - frame_sent;
+        if (chunk > space) {
+            chunk = space;
+        }
+        sink->write(frame + frame_sent, chunk);
+        frame_sent += chunk;
+        space -= chunk;
+        metrics.bytes_sent += chunk;
+        if (frame_sent == frame_length) {
+            metrics.frames_sent++;
+        }
+    }
+}
+
+telemetry_metrics_t get_telemetry_metrics(void) {
+    return metrics;
+}
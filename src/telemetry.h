@@ -0,0 +1,109 @@
+/**************************************************************************//**
+ *
+ * @file telemetry.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief A binary telemetry channel: typed records are queued in a RAM ring
+ *      and drained over Serial as COBS frames, a little at a time, without
+ *      ever blocking the main loop.
+ *
+ * Each frame is a zero byte, then the COBS encoding of
+ * <code>{type, sequence, timestamp_us (4 bytes, little-endian), payload,
+ * crc8}</code>, then another zero byte. The leading zero keeps any text
+ * printed between frames out of the next frame; host/telemetry-decoder.c
+ * shows such text as-is.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_TELEMETRY_H
+#define COMBOLOCK_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "rotary-encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_QUEUE_LENGTH      (64)
+#define TELEMETRY_MAXIMUM_PAYLOAD   (8)
+#define TELEMETRY_HEADER_SIZE       (6)
+#define TELEMETRY_MAXIMUM_FRAME     (TELEMETRY_HEADER_SIZE + TELEMETRY_MAXIMUM_PAYLOAD + 1 + 3)
+
+typedef enum {
+    TELEMETRY_DETENT = 1,       // payload: direction_t, then the number of detents
+    TELEMETRY_STATE = 2,        // payload: previous state, new state (the same, at startup)
+    TELEMETRY_BAD_TRIES = 3,    // payload: count
+    TELEMETRY_SERVO = 4,        // payload: pulse width in microseconds (2 bytes)
+    TELEMETRY_LOOP = 5,         // payload: iterations in the last second, longest iteration in microseconds (4+4)
+    TELEMETRY_DROPPED = 6,      // payload: records lost because the queue was full (4 bytes)
+} telemetry_type_t;
+
+/**
+ * Where the encoded frames go.
+ */
+typedef struct {
+    int (*available_for_write)(void);
+    void (*write)(uint8_t const *bytes, int length);
+} telemetry_sink_t;
+
+typedef struct {
+    uint32_t records;
+    uint32_t dropped_records;
+    uint32_t frames_sent;
+    uint32_t bytes_sent;
+} telemetry_metrics_t;
+
+/**
+ * @return The sink for this platform: Serial on the RP2040; on the host, the
+ *      file named by the COMBOLOCK_TELEMETRY environment variable, or
+ *      <code>NULL</code> if it is not set
+ */
+telemetry_sink_t const *get_telemetry_sink(void);
+
+/**
+ * Empties the queue and starts sending to `sink`. With a <code>NULL</code>
+ * sink, records are discarded as they are emitted.
+ */
+void initialize_telemetry(telemetry_sink_t const *sink);
+
+/**
+ * Queues a record, or counts it as dropped if the queue is full. Call only
+ * from the main loop.
+ */
+void emit_telemetry(telemetry_type_t type, void const *payload, uint8_t length);
+
+void emit_detent_telemetry(int detents);                // net detents, positive clockwise; ignores 0
+void emit_state_telemetry(uint8_t previous_state, uint8_t new_state);
+void emit_bad_tries_telemetry(uint8_t bad_tries);
+void emit_servo_telemetry(uint16_t pulse_width_us);
+
+/**
+ * Sends as much of the queue as the sink will take without blocking, and
+ * emits a TELEMETRY_LOOP record once a second. Call once per loop()
+ * iteration.
+ */
+void service_telemetry(void);
+
+/**
+ * Encodes the oldest queued record into `frame` without sending it.
+ *
+ * @return The frame's length, or 0 if the queue is empty
+ */
+int encode_telemetry_frame(uint8_t frame[TELEMETRY_MAXIMUM_FRAME]);
+
+telemetry_metrics_t get_telemetry_metrics(void);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_TELEMETRY_H
@@ -0,0 +1,46 @@
+/**************************************************************************//**
+ *
+ * @file time-service.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Code to read the 64-bit clock.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "registers.h"
+#include "time-service.h"
+
+#ifdef COMBOLOCK_HOST
+#include "host-hal.h"
+
+uint64_t get_time_us(void) {
+    return get_host_time_us();
+}
+
+#else
+
+static cowpi_timer_t volatile *const timer = TIMER_REGISTERS;
+
+/* TIMEHR/TIMELR latch the high word when the low word is read, which an ISR
+ * reading the clock in between would spoil; the raw registers do not latch. */
+uint64_t get_time_us(void) {
+    uint32_t upper = timer->raw_upper_word;
+    while (true) {
+        uint32_t lower = timer->raw_lower_word;
+        uint32_t upper_again = timer->raw_upper_word;
+        if (upper == upper_again) {
+            return ((uint64_t) upper << 32) | lower;
+        }
+        upper = upper_again;
+    }
+}
+
+#endif //COMBOLOCK_HOST
@@ -0,0 +1,69 @@
+/**************************************************************************//**
+ *
+ * @file time-service.h
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The firmware's clock: microseconds since boot, 64 bits wide so that
+ *      it never wraps, and deadlines measured against it.
+ *
+ * On the RP2040 the clock is the timer's raw 64-bit count, read without
+ * locks or the latching TIMEHR/TIMELR pair: the high word is read before and
+ * after the low word, and the read is retried if the low word wrapped in
+ * between. On the host the clock is the host HAL's, which is either the real
+ * monotonic clock or, with use_host_virtual_time(), a virtual one that jumps
+ * straight to the next timer deadline whenever the firmware would wait.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#ifndef COMBOLOCK_TIME_SERVICE_H
+#define COMBOLOCK_TIME_SERVICE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t deadline_t;
+
+/**
+ * @return Microseconds since boot. Safe to call from ISRs.
+ */
+uint64_t get_time_us(void);
+
+static inline uint32_t get_time_ms(void) {
+    return (uint32_t) (get_time_us() / 1000);
+}
+
+/**
+ * @return The deadline `delay_us` microseconds from now
+ */
+static inline deadline_t deadline_in_us(uint64_t delay_us) {
+    return get_time_us() + delay_us;
+}
+
+static inline bool deadline_has_passed(deadline_t deadline) {
+    return get_time_us() >= deadline;
+}
+
+/**
+ * @return The microseconds left before `deadline`, or 0 if it has passed
+ */
+static inline uint64_t time_until(deadline_t deadline) {
+    uint64_t now = get_time_us();
+    return (now < deadline) ? deadline - now : 0;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //COMBOLOCK_TIME_SERVICE_H
@@ -0,0 +1,42 @@
+/**************************************************************************//**
+ *
+ * @file watchdog.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief The deadline monitor's view of the RP2040's hardware watchdog,
+ *      through MBED's Watchdog driver.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include "deadline-monitor.h"
+
+#ifdef __MBED__
+#include <Watchdog.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void start_watchdog(uint32_t timeout_ms) {
+    mbed::Watchdog &watchdog = mbed::Watchdog::get_instance();
+    uint32_t longest = watchdog.get_max_timeout();
+    watchdog.start((timeout_ms < longest) ? timeout_ms : longest);
+}
+
+void kick_watchdog(void) {
+    mbed::Watchdog::get_instance().kick();
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif //__MBED__
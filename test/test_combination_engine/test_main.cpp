@@ -0,0 +1,185 @@
+/**************************************************************************//**
+ *
+ * @file test_main.cpp
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the combination rules for several dial sizes and combination
+ *      lengths, each instantiated here rather than chosen by the build: the
+ *      dial arithmetic against the plain division it replaces, dialing the
+ *      combination, and turn_by() against turn() one detent at a time.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include "combination-engine.hpp"
+
+using combolock::combination_engine;
+using combolock::pass_counts;
+
+template<typename Engine>
+struct entry_for {
+    uint8_t current_number;
+    uint8_t entry_stage;
+    direction_t correct_direction;
+    uint8_t entered_combination[Engine::length];
+    uint8_t visible_counts[Engine::length];
+};
+
+typedef combination_engine<16, pass_counts<3, 2, 1>> engine_16_3;
+typedef combination_engine<40, pass_counts<4, 3, 2, 1>> engine_40_4;
+typedef combination_engine<10, pass_counts<2, 1>> engine_10_2;
+typedef combination_engine<60, pass_counts<3, 2, 1>> engine_60_3;
+typedef combination_engine<100, pass_counts<5, 4, 3, 2, 1>> engine_100_5;
+typedef combination_engine<64, pass_counts<1, 1, 1, 1, 1, 1>> engine_64_6;
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+template<typename Engine>
+static void check_dial_arithmetic() {
+    typedef typename Engine::dial dial;
+    unsigned const positions = Engine::dial_positions;
+    unsigned const samples[] = {0, 1, positions - 1, positions, positions + 1, 2 * positions - 1, 1000, 65535,
+                                0x7FFFFFFF, 0x80000000};
+    for (unsigned steps : samples) {
+        TEST_ASSERT_EQUAL_UINT32(steps / positions, dial::split(steps).laps);
+        TEST_ASSERT_EQUAL_UINT32(steps % positions, dial::split(steps).detents);
+    }
+    for (int i = 0; i < 10000; i++) {
+        unsigned steps = (unsigned) rand();
+        TEST_ASSERT_EQUAL_UINT32(steps / positions, dial::split(steps).laps);
+        TEST_ASSERT_EQUAL_UINT32(steps % positions, dial::split(steps).detents);
+    }
+    for (unsigned number = 0; number < positions; number++) {
+        for (unsigned steps = 0; steps <= positions; steps++) {
+            TEST_ASSERT_EQUAL_UINT8((number + steps) % positions, dial::forward((uint8_t) number, steps));
+            TEST_ASSERT_EQUAL_UINT8((number + positions - steps) % positions, dial::backward((uint8_t) number, steps));
+        }
+    }
+}
+
+template<typename Engine>
+struct passes_of;
+
+template<unsigned Positions, typename Passes>
+struct passes_of<combination_engine<Positions, Passes>> {
+    typedef Passes type;
+};
+
+/* Dials a combination the way a person would: the first number clockwise,
+ * each later one the other way, passing each the required number of times
+ * and the first `extra_laps` more. */
+template<typename Engine>
+static void dial_combination(entry_for<Engine> &entry, uint8_t const combination[], unsigned extra_laps) {
+    typedef typename passes_of<Engine>::type passes;
+    unsigned const positions = Engine::dial_positions;
+    Engine::clear(entry);
+    for (unsigned stage = 0; stage < Engine::length; stage++) {
+        direction_t direction = (stage % 2 == 0) ? CLOCKWISE : COUNTERCLOCKWISE;
+        int sign = (direction == CLOCKWISE) ? 1 : -1;
+        if (stage > 0) {
+            Engine::turn_by(entry, sign, combination);     // the reversal that moves on to this number
+        }
+        uint8_t current = entry.current_number;
+        unsigned first_pass = (direction == CLOCKWISE) ? Engine::dial::distance(current, combination[stage])
+                                                       : Engine::dial::distance(combination[stage], current);
+        if (first_pass == 0) {
+            first_pass = positions;
+        }
+        unsigned required = passes::values[stage] + ((stage == 0) ? extra_laps : 0);
+        if (required > 0) {
+            Engine::turn_by(entry, sign * (int) (first_pass + (required - 1) * positions), combination);
+        }
+    }
+}
+
+template<typename Engine>
+static void check_default_combination_opens() {
+    uint8_t combination[Engine::length];
+    for (unsigned i = 0; i < Engine::length; i++) {
+        combination[i] = Engine::default_number(i);
+    }
+    entry_for<Engine> entry;
+    dial_combination(entry, combination, 0);
+    TEST_ASSERT_TRUE(Engine::is_final(entry));
+    TEST_ASSERT_EQUAL_MEMORY(combination, entry.entered_combination, Engine::length);
+    TEST_ASSERT_TRUE(Engine::matches(entry, combination));
+    dial_combination(entry, combination, 2);
+    TEST_ASSERT_TRUE(Engine::matches(entry, combination));
+    // one lap too many on the last number
+    Engine::turn_by(entry, ((Engine::length % 2) ? 1 : -1) * (int) Engine::dial_positions, combination);
+    TEST_ASSERT_FALSE(Engine::matches(entry, combination));
+}
+
+template<typename Engine>
+static void check_turn_by_matches_single_detents() {
+    uint8_t combination[Engine::length];
+    for (unsigned i = 0; i < Engine::length; i++) {
+        combination[i] = (uint8_t) (rand() % Engine::dial_positions);
+    }
+    entry_for<Engine> stepped;
+    entry_for<Engine> jumped;
+    Engine::clear(stepped);
+    Engine::clear(jumped);
+    for (int turn = 0; turn < 20000; turn++) {
+        int detents = rand() % (5 * Engine::dial_positions) - (int) (5 * Engine::dial_positions / 2);
+        if (rand() % 4 == 0) {
+            detents = (rand() % 2) ? 1 : -1;
+        }
+        for (int i = 0; i < abs(detents); i++) {
+            Engine::turn(stepped, (detents > 0) ? CLOCKWISE : COUNTERCLOCKWISE, combination);
+        }
+        Engine::turn_by(jumped, detents, combination);
+        // field by field, as the padding after correct_direction is never written
+        TEST_ASSERT_EQUAL_UINT8(stepped.current_number, jumped.current_number);
+        TEST_ASSERT_EQUAL_UINT8(stepped.entry_stage, jumped.entry_stage);
+        TEST_ASSERT_EQUAL(stepped.correct_direction, jumped.correct_direction);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(stepped.entered_combination, jumped.entered_combination, Engine::length);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(stepped.visible_counts, jumped.visible_counts, Engine::length);
+    }
+}
+
+#define CONFIGURATION_TESTS(engine)                                 \
+    static void test_dial_arithmetic_##engine(void) {               \
+        check_dial_arithmetic<engine>();                            \
+    }                                                               \
+    static void test_default_combination_##engine(void) {           \
+        check_default_combination_opens<engine>();                  \
+    }                                                               \
+    static void test_turn_by_##engine(void) {                       \
+        check_turn_by_matches_single_detents<engine>();             \
+    }
+
+CONFIGURATION_TESTS(engine_16_3)
+CONFIGURATION_TESTS(engine_40_4)
+CONFIGURATION_TESTS(engine_10_2)
+CONFIGURATION_TESTS(engine_60_3)
+CONFIGURATION_TESTS(engine_100_5)
+CONFIGURATION_TESTS(engine_64_6)
+
+#define RUN_CONFIGURATION_TESTS(engine)                             \
+    RUN_TEST(test_dial_arithmetic_##engine);                        \
+    RUN_TEST(test_default_combination_##engine);                    \
+    RUN_TEST(test_turn_by_##engine)
+
+int main(int argc, char *argv[]) {
+    srand(1);
+    UNITY_BEGIN();
+    RUN_CONFIGURATION_TESTS(engine_16_3);
+    RUN_CONFIGURATION_TESTS(engine_40_4);
+    RUN_CONFIGURATION_TESTS(engine_10_2);
+    RUN_CONFIGURATION_TESTS(engine_60_3);
+    RUN_CONFIGURATION_TESTS(engine_100_5);
+    RUN_CONFIGURATION_TESTS(engine_64_6);
+    return UNITY_END();
+}
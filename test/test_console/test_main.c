@@ -0,0 +1,147 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the console's line handling through a fake port whose bytes
+ *      arrive a few at a time, as they do over Serial: lines split across
+ *      calls, line endings, editing, and lines longer than the limit.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "console.h"
+#include "host-hal.h"
+
+static char received[256];
+static size_t received_length;
+static size_t read_position;
+static int runs;
+static char last_arguments[CONSOLE_LINE_LENGTH + 1];
+
+static int read_fake_port(void) {
+    return (read_position < received_length) ? (unsigned char) received[read_position++] : -1;
+}
+
+static console_port_t const fake_port = {.read = read_fake_port};
+
+/* Bytes that have arrived since the last call, as if Serial had buffered them. */
+static void arrive(char const *bytes) {
+    size_t length = strlen(bytes);
+    memcpy(received + received_length, bytes, length);
+    received_length += length;
+}
+
+static void run_echo(char const *arguments) {
+    strcpy(last_arguments, arguments);
+    runs++;
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    received_length = 0;
+    read_position = 0;
+    runs = 0;
+    last_arguments[0] = '\0';
+    initialize_console(&fake_port);
+    register_console_command("echo", run_echo, "repeats its arguments");
+}
+
+void tearDown(void) {}
+
+static void test_line_split_across_calls_runs_once_complete(void) {
+    arrive("ec");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    arrive("ho  two ");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    arrive("words");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(0, runs);
+    arrive("\r");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(1, runs);
+    TEST_ASSERT_EQUAL_STRING("two words", last_arguments);
+}
+
+static void test_crlf_and_empty_lines_run_nothing_extra(void) {
+    arrive("  echo a\r\n\r\n\necho b\n");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_STRING("a", last_arguments);
+    // one command per call; the blank lines between are skipped
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_STRING("b", last_arguments);
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(2, runs);
+}
+
+static void test_backspace_and_delete_edit_the_line(void) {
+    arrive("ecoh\b\bho xy\x7fz\b\b\b\b");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    arrive("\b\b\b\becho ok\r");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(1, runs);
+    TEST_ASSERT_EQUAL_STRING("ok", last_arguments);
+}
+
+static void test_overlong_line_is_refused_and_the_next_one_runs(void) {
+    char longest[CONSOLE_LINE_LENGTH + 1];
+    memcpy(longest, "echo ", 5);
+    memset(longest + 5, 'x', CONSOLE_LINE_LENGTH - 5);
+    longest[CONSOLE_LINE_LENGTH] = '\0';
+    arrive(longest);
+    // one character too many, arriving in a later fragment
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    arrive("yyyyyyyyyyyyyyyyyyyy");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    arrive("\r\n");
+    TEST_ASSERT_FALSE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(0, runs);
+    // the limit itself is fine, and nothing of the refused line is left over
+    arrive(longest);
+    arrive("\r");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(1, runs);
+    TEST_ASSERT_EQUAL_STRING(longest + 5, last_arguments);
+}
+
+static void test_garbage_and_unknown_commands_run_nothing(void) {
+    arrive("\x01\x1b" "ec\x80ho\xff z\r");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(1, runs);
+    TEST_ASSERT_EQUAL_STRING("z", last_arguments);
+    arrive("echoes\r");
+    TEST_ASSERT_TRUE(service_console(CONSOLE_SLICE_US));
+    TEST_ASSERT_EQUAL_INT(1, runs);
+}
+
+static void test_commands_are_replaced_and_limited(void) {
+    TEST_ASSERT_TRUE(register_console_command("echo", run_echo, "replaced"));
+    int added = 0;
+    static char const *const names[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    while (register_console_command(names[added], run_echo, "")) {
+        added++;
+    }
+    // five built-in commands and echo
+    TEST_ASSERT_EQUAL_INT(MAXIMUM_CONSOLE_COMMANDS - 6, added);
+    TEST_ASSERT_TRUE(register_console_command("echo", run_echo, "still replaceable"));
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_line_split_across_calls_runs_once_complete);
+    RUN_TEST(test_crlf_and_empty_lines_run_nothing_extra);
+    RUN_TEST(test_backspace_and_delete_edit_the_line);
+    RUN_TEST(test_overlong_line_is_refused_and_the_next_one_runs);
+    RUN_TEST(test_garbage_and_unknown_commands_run_nothing);
+    RUN_TEST(test_commands_are_replaced_and_limited);
+    return UNITY_END();
+}
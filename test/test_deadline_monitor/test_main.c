@@ -0,0 +1,111 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests that the deadline monitor blames an overrun on the subsystem
+ *      that used the most of the iteration, and that a stalled or
+ *      persistently late loop lets the watchdog expire.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "deadline-monitor.h"
+#include "flight-recorder.h"
+#include "host-hal.h"
+
+#define BUDGET_US   (100000)
+
+/* One loop() iteration in which each subsystem takes the given time. */
+static bool iterate(uint32_t control_lock_us, uint32_t display_us, uint32_t housekeeping_us) {
+    start_loop_iteration();
+    advance_host_time(control_lock_us);
+    end_subsystem(SUBSYSTEM_CONTROL_LOCK);
+    advance_host_time(display_us);
+    end_subsystem(SUBSYSTEM_DISPLAY);
+    advance_host_time(housekeeping_us);
+    end_subsystem(SUBSYSTEM_HOUSEKEEPING);
+    return end_loop_iteration();
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    discard_flight_recorder();
+    initialize_flight_recorder();
+    initialize_deadline_monitor(BUDGET_US);
+}
+
+void tearDown(void) {}
+
+static void test_iteration_within_budget_kicks_the_watchdog(void) {
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_TRUE(iterate(20000, 60000, 20000));
+    }
+    deadline_metrics_t metrics = get_deadline_metrics();
+    TEST_ASSERT_EQUAL_UINT32(100, metrics.iterations);
+    TEST_ASSERT_EQUAL_UINT32(0, metrics.overruns);
+    TEST_ASSERT_EQUAL_UINT32(100, metrics.watchdog_kicks);
+    TEST_ASSERT_EQUAL_UINT32(BUDGET_US, metrics.last_iteration_us);
+    TEST_ASSERT_FALSE(host_watchdog_has_expired());
+}
+
+static void test_overrun_is_blamed_on_the_slowest_subsystem(void) {
+    flight_event_t events[FLIGHT_RECORDER_LENGTH];
+    TEST_ASSERT_FALSE(iterate(10000, 95000, 30000));
+    TEST_ASSERT_FALSE(iterate(70000, 40000, 1000));
+    deadline_metrics_t metrics = get_deadline_metrics();
+    TEST_ASSERT_EQUAL_UINT32(2, metrics.overruns);
+    TEST_ASSERT_EQUAL_UINT32(1, metrics.overruns_by_subsystem[SUBSYSTEM_DISPLAY]);
+    TEST_ASSERT_EQUAL_UINT32(1, metrics.overruns_by_subsystem[SUBSYSTEM_CONTROL_LOCK]);
+    TEST_ASSERT_EQUAL_UINT32(135000, metrics.worst_iteration_us);
+    TEST_ASSERT_EQUAL_UINT8(SUBSYSTEM_DISPLAY, metrics.worst_subsystem);
+    TEST_ASSERT_EQUAL_UINT32(0, metrics.watchdog_kicks);
+    int count = get_flight_events(events);
+    TEST_ASSERT_EQUAL_INT(3, count);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_DEADLINE, events[1].type);
+    TEST_ASSERT_EQUAL_UINT8(SUBSYSTEM_DISPLAY, events[1].a);
+    TEST_ASSERT_EQUAL_UINT16(135, events[1].b);
+    TEST_ASSERT_EQUAL_UINT8(SUBSYSTEM_CONTROL_LOCK, events[2].a);
+    TEST_ASSERT_EQUAL_UINT16(111, events[2].b);
+}
+
+static void test_stalled_subsystem_lets_the_watchdog_expire(void) {
+    TEST_ASSERT_TRUE(iterate(1000, 1000, 1000));
+    // the display never returns, so the iteration never ends
+    start_loop_iteration();
+    advance_host_time(1000);
+    end_subsystem(SUBSYSTEM_CONTROL_LOCK);
+    advance_host_time(COMBOLOCK_WATCHDOG_TIMEOUT_MS * 1000 - 1000);
+    TEST_ASSERT_FALSE(host_watchdog_has_expired());
+    advance_host_time(1);
+    TEST_ASSERT_TRUE(host_watchdog_has_expired());
+}
+
+static void test_persistent_overruns_let_the_watchdog_expire(void) {
+    int iterations = 0;
+    while (!host_watchdog_has_expired()) {
+        TEST_ASSERT_FALSE(iterate(1000, 1000, BUDGET_US));
+        iterations++;
+    }
+    TEST_ASSERT_EQUAL_INT(COMBOLOCK_WATCHDOG_TIMEOUT_MS * 1000 / (BUDGET_US + 2000) + 1, iterations);
+    deadline_metrics_t metrics = get_deadline_metrics();
+    TEST_ASSERT_EQUAL_UINT32(iterations, metrics.overruns_by_subsystem[SUBSYSTEM_HOUSEKEEPING]);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_iteration_within_budget_kicks_the_watchdog);
+    RUN_TEST(test_overrun_is_blamed_on_the_slowest_subsystem);
+    RUN_TEST(test_stalled_subsystem_lets_the_watchdog_expire);
+    RUN_TEST(test_persistent_overruns_let_the_watchdog_expire);
+    return UNITY_END();
+}
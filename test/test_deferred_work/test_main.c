@@ -0,0 +1,210 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Stress-tests the deferred-work queues with several simulated
+ *      interrupt sources posting on host timers while the loop drains them,
+ *      including interrupts that arrive in the middle of a drain.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <stdlib.h>
+#include <unity.h>
+#include "deferred-work.h"
+#include "host-hal.h"
+#include "interrupt_support.h"
+
+#define NUMBER_OF_SOURCES   (5)
+#define SOURCE_SHIFT        (24)
+#define SEQUENCE_MASK       ((1u << SOURCE_SHIFT) - 1)
+
+typedef struct {
+    work_priority_t priority;
+    uint32_t attempts;
+    uint32_t accepted;
+    uint32_t ran;
+    uint32_t last_sequence_run;
+} source_t;
+
+static source_t sources[NUMBER_OF_SOURCES];
+static bool sources_are_running;
+static deferred_queue_stats_t before[NUMBER_OF_WORK_PRIORITIES];
+static uint32_t order[4 * DEFERRED_QUEUE_LENGTH];
+static int number_run;
+
+static void record_item(uint32_t argument) {
+    order[number_run++] = argument;
+}
+
+/* Each item lets a little time pass, so that the sources' interrupts also
+ * land in the middle of a drain. */
+static void handle_item(uint32_t argument) {
+    source_t *source = &sources[argument >> SOURCE_SHIFT];
+    uint32_t sequence = argument & SEQUENCE_MASK;
+    if (source->ran > 0) {
+        TEST_ASSERT_GREATER_THAN_UINT32(source->last_sequence_run, sequence);
+    }
+    source->last_sequence_run = sequence;
+    source->ran++;
+    advance_host_time((uint64_t) (rand() % 40));
+}
+
+static void post_from(int number) {
+    source_t *source = &sources[number];
+    if (!sources_are_running) {
+        return;
+    }
+    uint32_t argument = ((uint32_t) number << SOURCE_SHIFT) | source->attempts++;
+    if (defer_work(source->priority, handle_item, argument)) {
+        source->accepted++;
+    }
+}
+
+static void handle_source_0_interrupt(void) {
+    post_from(0);
+}
+
+static void handle_source_1_interrupt(void) {
+    post_from(1);
+}
+
+static void handle_source_2_interrupt(void) {
+    post_from(2);
+}
+
+static void handle_source_3_interrupt(void) {
+    post_from(3);
+}
+
+static void handle_source_4_interrupt(void) {
+    post_from(4);
+}
+
+static void (*const source_isrs[NUMBER_OF_SOURCES])(void) = {
+        handle_source_0_interrupt, handle_source_1_interrupt, handle_source_2_interrupt,
+        handle_source_3_interrupt, handle_source_4_interrupt
+};
+
+static void drain(void) {
+    while (run_deferred_work(DEFERRED_WORK_SLICE_US) > 0) {}
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    sources_are_running = false;
+    drain();
+    get_deferred_work_stats(before);
+    number_run = 0;
+}
+
+void tearDown(void) {
+    sources_are_running = false;
+}
+
+static void test_priorities_run_highest_first_and_in_order(void) {
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_LOW, record_item, 20));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_NORMAL, record_item, 10));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_HIGH, record_item, 0));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_LOW, record_item, 21));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_HIGH, record_item, 1));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_NORMAL, record_item, 11));
+    TEST_ASSERT_EQUAL_UINT(6, run_deferred_work(DEFERRED_WORK_SLICE_US));
+    uint32_t const expected[] = {0, 1, 10, 11, 20, 21};
+    TEST_ASSERT_EQUAL_INT(6, number_run);
+    TEST_ASSERT_EQUAL_UINT32_ARRAY(expected, order, 6);
+}
+
+static void test_full_queue_refuses_and_recovers(void) {
+    deferred_queue_stats_t after[NUMBER_OF_WORK_PRIORITIES];
+    for (uint32_t i = 0; i < DEFERRED_QUEUE_LENGTH; i++) {
+        TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_NORMAL, record_item, i));
+    }
+    TEST_ASSERT_FALSE(defer_work(WORK_PRIORITY_NORMAL, record_item, DEFERRED_QUEUE_LENGTH));
+    // the other priorities have queues of their own
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_LOW, record_item, 100));
+    get_deferred_work_stats(after);
+    TEST_ASSERT_EQUAL_UINT32(1, after[WORK_PRIORITY_NORMAL].overflows - before[WORK_PRIORITY_NORMAL].overflows);
+    TEST_ASSERT_EQUAL_UINT8(DEFERRED_QUEUE_LENGTH, after[WORK_PRIORITY_NORMAL].depth);
+    TEST_ASSERT_EQUAL_UINT8(DEFERRED_QUEUE_LENGTH, after[WORK_PRIORITY_NORMAL].maximum_depth);
+    // even a budget that has already run out runs one item
+    TEST_ASSERT_EQUAL_UINT(1, run_deferred_work(0));
+    TEST_ASSERT_TRUE(defer_work(WORK_PRIORITY_NORMAL, record_item, DEFERRED_QUEUE_LENGTH + 1));
+    drain();
+    TEST_ASSERT_EQUAL_INT(DEFERRED_QUEUE_LENGTH + 2, number_run);
+    for (int i = 0; i < DEFERRED_QUEUE_LENGTH; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, order[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(DEFERRED_QUEUE_LENGTH + 1, order[DEFERRED_QUEUE_LENGTH]);
+    TEST_ASSERT_EQUAL_UINT32(100, order[DEFERRED_QUEUE_LENGTH + 1]);
+}
+
+/* Five sources post every 110-370 us while the loop drains in short slices
+ * at random intervals, and every 50 ms the loop stalls for long enough that
+ * the busiest queues overflow. Nothing accepted may be lost, run twice or run
+ * out of its source's order, and the counters must add up. */
+static void test_interrupt_sources_against_the_loop(void) {
+    static work_priority_t const priorities[NUMBER_OF_SOURCES] = {
+            WORK_PRIORITY_HIGH, WORK_PRIORITY_HIGH, WORK_PRIORITY_NORMAL, WORK_PRIORITY_NORMAL, WORK_PRIORITY_LOW
+    };
+    static uint32_t const periods_us[NUMBER_OF_SOURCES] = {110, 170, 230, 290, 370};
+    deferred_queue_stats_t after[NUMBER_OF_WORK_PRIORITIES];
+    srand(42);
+    memset(sources, 0, sizeof(sources));
+    for (int i = 0; i < NUMBER_OF_SOURCES; i++) {
+        sources[i].priority = priorities[i];
+        TEST_ASSERT_TRUE(register_periodic_timer_ISR(i, periods_us[i], source_isrs[i]));
+    }
+    sources_are_running = true;
+    uint64_t end = get_host_time_us() + 500000;
+    uint64_t next_stall = get_host_time_us() + 50000;
+    while (get_host_time_us() < end) {
+        advance_host_time((uint64_t) (rand() % 300));
+        if (get_host_time_us() >= next_stall) {
+            advance_host_time(3000);
+            next_stall += 50000;
+        }
+        run_deferred_work((uint32_t) (rand() % 400));
+    }
+    sources_are_running = false;
+    drain();
+
+    uint32_t attempts[NUMBER_OF_WORK_PRIORITIES] = {0};
+    uint32_t accepted[NUMBER_OF_WORK_PRIORITIES] = {0};
+    for (int i = 0; i < NUMBER_OF_SOURCES; i++) {
+        TEST_ASSERT_GREATER_THAN_UINT32(500000 / periods_us[i] / 2, sources[i].attempts);
+        TEST_ASSERT_EQUAL_UINT32(sources[i].accepted, sources[i].ran);
+        attempts[sources[i].priority] += sources[i].attempts;
+        accepted[sources[i].priority] += sources[i].accepted;
+    }
+    get_deferred_work_stats(after);
+    for (int priority = 0; priority < NUMBER_OF_WORK_PRIORITIES; priority++) {
+        uint32_t posted = after[priority].posted - before[priority].posted;
+        uint32_t run = after[priority].run - before[priority].run;
+        uint32_t overflows = after[priority].overflows - before[priority].overflows;
+        TEST_ASSERT_EQUAL_UINT32(accepted[priority], posted);
+        TEST_ASSERT_EQUAL_UINT32(posted, run);
+        TEST_ASSERT_EQUAL_UINT32(attempts[priority], posted + overflows);
+        TEST_ASSERT_EQUAL_UINT8(0, after[priority].depth);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT8(DEFERRED_QUEUE_LENGTH, after[priority].maximum_depth);
+    }
+    // the stalls are long enough to overflow the high-priority queue
+    TEST_ASSERT_GREATER_THAN_UINT32(0, after[WORK_PRIORITY_HIGH].overflows - before[WORK_PRIORITY_HIGH].overflows);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_priorities_run_highest_first_and_in_order);
+    RUN_TEST(test_full_queue_refuses_and_recovers);
+    RUN_TEST(test_interrupt_sources_against_the_loop);
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests that the encoder's net detent delta adds up the detents
+ *      turned since it was last taken, and that applying a whole delta with
+ *      turn_dial_by() leaves the combination entry exactly as applying its
+ *      detents one at a time with turn_dial() would.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <stdlib.h>
+#include <unity.h>
+#include "combination-engine.h"
+#include "detent-delta.h"
+#include "host-hal.h"
+#include "rotary-encoder.h"
+
+static uint8_t combination[COMBINATION_LENGTH];
+
+static void turn(direction_t direction, int detents) {
+    for (int i = 0; i < detents; i++) {
+        turn_host_dial(direction);
+    }
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    initialize_rotary_encoder();
+    get_default_combination(combination);
+}
+
+void tearDown(void) {}
+
+static void test_delta_is_net_detents_since_last_taken(void) {
+    TEST_ASSERT_EQUAL_INT(0, take_detent_delta());
+    turn(CLOCKWISE, 5);
+    turn(COUNTERCLOCKWISE, 2);
+    TEST_ASSERT_EQUAL_INT(3, take_detent_delta());
+    TEST_ASSERT_EQUAL_INT(0, take_detent_delta());
+    turn(COUNTERCLOCKWISE, 3 * COMBOLOCK_DIAL_POSITIONS + 1);
+    TEST_ASSERT_EQUAL_INT(-(3 * COMBOLOCK_DIAL_POSITIONS + 1), take_detent_delta());
+}
+
+static void test_turn_dial_by_matches_single_detents(void) {
+    combination_entry_t stepped;
+    combination_entry_t jumped;
+    srand(1);
+    for (int trial = 0; trial < 200; trial++) {
+        for (int i = 0; i < COMBINATION_LENGTH; i++) {
+            combination[i] = (uint8_t) (rand() % COMBOLOCK_DIAL_POSITIONS);
+        }
+        clear_combination_entry(&stepped);
+        clear_combination_entry(&jumped);
+        for (int batch = 0; batch < 200; batch++) {
+            // mostly small turns, as between two loop iterations, and some of several laps
+            int limit = (rand() % 8 == 0) ? 5 * COMBOLOCK_DIAL_POSITIONS : 4;
+            int detents = rand() % (2 * limit + 1) - limit;
+            turn((detents > 0) ? CLOCKWISE : COUNTERCLOCKWISE, abs(detents));
+            int delta = take_detent_delta();
+            TEST_ASSERT_EQUAL_INT(detents, delta);
+            for (int i = 0; i < abs(delta); i++) {
+                turn_dial(&stepped, (delta > 0) ? CLOCKWISE : COUNTERCLOCKWISE, combination);
+            }
+            turn_dial_by(&jumped, delta, combination);
+            TEST_ASSERT_EQUAL_UINT8(stepped.current_number, jumped.current_number);
+            TEST_ASSERT_EQUAL_UINT8(stepped.entry_stage, jumped.entry_stage);
+            TEST_ASSERT_EQUAL(stepped.correct_direction, jumped.correct_direction);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(stepped.visible_counts, jumped.visible_counts, COMBINATION_LENGTH);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(stepped.entered_combination, jumped.entered_combination,
+                                          COMBINATION_LENGTH);
+            TEST_ASSERT_EQUAL(combination_entry_matches(&stepped, combination),
+                              combination_entry_matches(&jumped, combination));
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_delta_is_net_detents_since_last_taken);
+    RUN_TEST(test_turn_dial_by_matches_single_detents);
+    return UNITY_END();
+}
@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests that the flight recorder survives a reset but not a power
+ *      cycle, and that it keeps the newest events, oldest first, once it
+ *      wraps around.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "flight-recorder.h"
+#include "host-hal.h"
+
+static flight_event_t events[FLIGHT_RECORDER_LENGTH];
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    discard_flight_recorder();
+}
+
+void tearDown(void) {}
+
+static void test_power_cycle_formats_the_recorder(void) {
+    TEST_ASSERT_FALSE(initialize_flight_recorder());
+    TEST_ASSERT_EQUAL_INT(1, get_flight_events(events));
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_BOOT, events[0].type);
+    TEST_ASSERT_EQUAL_UINT8(0, events[0].a);
+}
+
+static void test_events_survive_a_reset(void) {
+    initialize_flight_recorder();
+    advance_host_time(1500);
+    record_flight_event(FLIGHT_STATE, 0, 1);
+    record_flight_event(FLIGHT_ALARM, 3, 0);
+    // a soft reset leaves the recorder's RAM as it was
+    TEST_ASSERT_TRUE(initialize_flight_recorder());
+    TEST_ASSERT_TRUE(initialize_flight_recorder());
+    TEST_ASSERT_EQUAL_INT(5, get_flight_events(events));
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_BOOT, events[0].type);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_STATE, events[1].type);
+    TEST_ASSERT_EQUAL_UINT8(0, events[1].a);
+    TEST_ASSERT_EQUAL_UINT16(1, events[1].b);
+    TEST_ASSERT_EQUAL_UINT32(events[0].timestamp_us + 1500, events[1].timestamp_us);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_ALARM, events[2].type);
+    TEST_ASSERT_EQUAL_UINT8(3, events[2].a);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_BOOT, events[3].type);
+    TEST_ASSERT_EQUAL_UINT8(1, events[3].a);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_BOOT, events[4].type);
+    TEST_ASSERT_EQUAL_UINT8(2, events[4].a);
+    discard_flight_recorder();
+    TEST_ASSERT_EQUAL_INT(0, get_flight_events(events));
+    TEST_ASSERT_FALSE(initialize_flight_recorder());
+    TEST_ASSERT_EQUAL_INT(1, get_flight_events(events));
+}
+
+static void test_wraparound_keeps_the_newest_events_in_order(void) {
+    int const recorded = 3 * FLIGHT_RECORDER_LENGTH + 5;
+    initialize_flight_recorder();
+    for (int i = 0; i < recorded; i++) {
+        record_flight_event(FLIGHT_OVERRUN, OVERRUN_KEYPAD_QUEUE, (uint16_t) i);
+        advance_host_time(10);
+    }
+    TEST_ASSERT_EQUAL_INT(FLIGHT_RECORDER_LENGTH, get_flight_events(events));
+    for (int i = 0; i < FLIGHT_RECORDER_LENGTH; i++) {
+        TEST_ASSERT_EQUAL_UINT8(FLIGHT_OVERRUN, events[i].type);
+        TEST_ASSERT_EQUAL_UINT16(recorded - FLIGHT_RECORDER_LENGTH + i, events[i].b);
+        if (i > 0) {
+            TEST_ASSERT_EQUAL_UINT32(events[i - 1].timestamp_us + 10, events[i].timestamp_us);
+        }
+    }
+    // and the wrapped recorder survives a reset, with the boot event newest
+    TEST_ASSERT_TRUE(initialize_flight_recorder());
+    TEST_ASSERT_EQUAL_INT(FLIGHT_RECORDER_LENGTH, get_flight_events(events));
+    TEST_ASSERT_EQUAL_UINT16(recorded - FLIGHT_RECORDER_LENGTH + 1, events[0].b);
+    TEST_ASSERT_EQUAL_UINT8(FLIGHT_BOOT, events[FLIGHT_RECORDER_LENGTH - 1].type);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_power_cycle_formats_the_recorder);
+    RUN_TEST(test_events_survive_a_reset);
+    RUN_TEST(test_wraparound_keeps_the_newest_events_in_order);
+    return UNITY_END();
+}
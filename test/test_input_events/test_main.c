@@ -0,0 +1,130 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the pushbutton and switch debouncer by feeding sample_inputs()
+ *      the levels that bouncing contacts would produce, one call per sample.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <stdlib.h>
+#include <unity.h>
+#include "host-hal.h"
+#include "input-events.h"
+
+#define LONG_PRESS_SAMPLES  (INPUT_LONG_PRESS_MS * 1000 / INPUT_SAMPLE_PERIOD_uS)
+
+static void sample(uint8_t levels, int samples) {
+    for (int i = 0; i < samples; i++) {
+        sample_inputs(levels);
+    }
+}
+
+/* Contacts that bounce for `bounces` random samples between `from` and `to`
+ * before settling on `to`. Going down and back up again takes at least two
+ * debounce windows, so any bounce shorter than that makes exactly one event. */
+static void bounce(uint8_t from, uint8_t to, int bounces) {
+    for (int i = 0; i < bounces; i++) {
+        sample_inputs((rand() % 2) ? to : from);
+    }
+    sample(to, INPUT_DEBOUNCE_SAMPLES);
+}
+
+static int count_events(uint8_t input, input_event_type_t type) {
+    input_event_t event;
+    int count = 0;
+    while (get_input_event(&event)) {
+        TEST_ASSERT_EQUAL_UINT8(input, event.input);
+        TEST_ASSERT_EQUAL_UINT8(type, event.type);
+        count++;
+    }
+    return count;
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    initialize_input_events();
+}
+
+void tearDown(void) {}
+
+static void test_clean_press_and_release(void) {
+    input_event_t event;
+    sample(0, 2);
+    sample(1 << LEFT_BUTTON, INPUT_DEBOUNCE_SAMPLES - 1);
+    TEST_ASSERT_FALSE(get_input_event(&event));
+    TEST_ASSERT_FALSE(input_is_pressed(LEFT_BUTTON));
+    sample(1 << LEFT_BUTTON, 1);
+    TEST_ASSERT_TRUE(input_is_pressed(LEFT_BUTTON));
+    TEST_ASSERT_TRUE(get_input_event(&event));
+    TEST_ASSERT_EQUAL_UINT8(LEFT_BUTTON, event.input);
+    TEST_ASSERT_EQUAL_UINT8(INPUT_PRESSED, event.type);
+    TEST_ASSERT_EQUAL_UINT32((2 + INPUT_DEBOUNCE_SAMPLES) * INPUT_SAMPLE_PERIOD_uS / 1000, event.timestamp_ms);
+    sample(0, INPUT_DEBOUNCE_SAMPLES);
+    TEST_ASSERT_FALSE(input_is_pressed(LEFT_BUTTON));
+    TEST_ASSERT_EQUAL_INT(1, count_events(LEFT_BUTTON, INPUT_RELEASED));
+}
+
+static void test_exactly_one_event_per_press_under_bounce(void) {
+    srand(1);
+    for (int press = 0; press < 2000; press++) {
+        uint8_t input = (uint8_t) (press % NUMBER_OF_INPUTS);
+        uint8_t level = 1 << input;
+        bounce(0, level, rand() % (2 * INPUT_DEBOUNCE_SAMPLES));
+        sample(level, rand() % 20);
+        TEST_ASSERT_TRUE(input_is_pressed(input));
+        TEST_ASSERT_EQUAL_INT(1, count_events(input, INPUT_PRESSED));
+        bounce(level, 0, rand() % (2 * INPUT_DEBOUNCE_SAMPLES));
+        sample(0, rand() % 20);
+        TEST_ASSERT_FALSE(input_is_pressed(input));
+        TEST_ASSERT_EQUAL_INT(1, count_events(input, INPUT_RELEASED));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, get_dropped_input_events());
+}
+
+static void test_long_press_is_reported_once(void) {
+    input_event_t event;
+    sample(1 << RIGHT_BUTTON, INPUT_DEBOUNCE_SAMPLES);
+    TEST_ASSERT_EQUAL_INT(1, count_events(RIGHT_BUTTON, INPUT_PRESSED));
+    sample(1 << RIGHT_BUTTON, LONG_PRESS_SAMPLES - 1);
+    TEST_ASSERT_FALSE(get_input_event(&event));
+    // a bounce in the middle of the hold neither releases nor restarts it
+    sample(0, INPUT_DEBOUNCE_SAMPLES - 1);
+    sample(1 << RIGHT_BUTTON, 1);
+    TEST_ASSERT_EQUAL_INT(1, count_events(RIGHT_BUTTON, INPUT_LONG_PRESSED));
+    sample(1 << RIGHT_BUTTON, 3 * LONG_PRESS_SAMPLES);
+    TEST_ASSERT_FALSE(get_input_event(&event));
+    sample(0, INPUT_DEBOUNCE_SAMPLES);
+    TEST_ASSERT_EQUAL_INT(1, count_events(RIGHT_BUTTON, INPUT_RELEASED));
+}
+
+static void test_switch_already_on_at_startup_makes_no_event(void) {
+    input_event_t event;
+    set_host_switch(HOST_LEFT, true);
+    initialize_input_events();
+    TEST_ASSERT_TRUE(input_is_pressed(LEFT_SWITCH));
+    sample(1 << LEFT_SWITCH, 3 * LONG_PRESS_SAMPLES);
+    TEST_ASSERT_FALSE(get_input_event(&event));
+    bounce(1 << LEFT_SWITCH, 0, INPUT_DEBOUNCE_SAMPLES);
+    TEST_ASSERT_EQUAL_INT(1, count_events(LEFT_SWITCH, INPUT_RELEASED));
+    set_host_switch(HOST_LEFT, false);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_press_and_release);
+    RUN_TEST(test_exactly_one_event_per_press_under_bounce);
+    RUN_TEST(test_long_press_is_reported_once);
+    RUN_TEST(test_switch_already_on_at_startup_makes_no_event);
+    return UNITY_END();
+}
@@ -0,0 +1,133 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the keypad debouncer by feeding scan_keypad() the samples a
+ *      bouncing key would produce, one call per scan.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <stdlib.h>
+#include <unity.h>
+#include "host-hal.h"
+#include "keypad.h"
+
+static void scan(char sample, int scans) {
+    for (int i = 0; i < scans; i++) {
+        scan_keypad(sample);
+    }
+}
+
+/* A contact that bounces for `bounces` random samples before settling on
+ * `settled`. Going down and back up again takes at least two debounce
+ * windows, so any bounce shorter than that makes exactly one event. */
+static void bounce_to(char key, char settled, int bounces) {
+    for (int i = 0; i < bounces; i++) {
+        scan_keypad((rand() % 2) ? key : 0);
+    }
+    scan(settled, KEYPAD_DEBOUNCE_SCANS);
+}
+
+static int count_events(char key, bool pressed) {
+    keypad_event_t event;
+    int count = 0;
+    while (get_keypad_event(&event)) {
+        TEST_ASSERT_EQUAL_CHAR(key, event.key);
+        TEST_ASSERT_EQUAL(pressed, event.pressed);
+        count++;
+    }
+    return count;
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    initialize_keypad();
+}
+
+void tearDown(void) {}
+
+static void test_clean_press_and_release(void) {
+    keypad_event_t event;
+    scan(0, 3);
+    scan('7', KEYPAD_DEBOUNCE_SCANS - 1);
+    TEST_ASSERT_FALSE(get_keypad_event(&event));
+    scan('7', 1);
+    TEST_ASSERT_TRUE(get_keypad_event(&event));
+    TEST_ASSERT_EQUAL_CHAR('7', event.key);
+    TEST_ASSERT_TRUE(event.pressed);
+    TEST_ASSERT_EQUAL_UINT32((3 + KEYPAD_DEBOUNCE_SCANS) * KEYPAD_SCAN_PERIOD_uS / 1000, event.timestamp_ms);
+    scan('7', 100);
+    TEST_ASSERT_FALSE(get_keypad_event(&event));
+    scan(0, KEYPAD_DEBOUNCE_SCANS);
+    TEST_ASSERT_TRUE(get_keypad_event(&event));
+    TEST_ASSERT_EQUAL_CHAR('7', event.key);
+    TEST_ASSERT_FALSE(event.pressed);
+}
+
+static void test_glitch_shorter_than_the_window_is_rejected(void) {
+    keypad_event_t event;
+    keypad_metrics_t metrics;
+    scan('#', KEYPAD_DEBOUNCE_SCANS - 1);
+    scan(0, KEYPAD_DEBOUNCE_SCANS);
+    TEST_ASSERT_FALSE(get_keypad_event(&event));
+    get_keypad_metrics(&metrics);
+    TEST_ASSERT_EQUAL_UINT32(1, metrics.rejected_bounces);
+    TEST_ASSERT_EQUAL_UINT32(0, metrics.events);
+}
+
+static void test_exactly_one_press_and_release_under_bounce(void) {
+    char const keys[] = "0123456789ABCD*#";
+    srand(1);
+    for (int press = 0; press < 2000; press++) {
+        char key = keys[press % 16];
+        int bounces = rand() % (2 * KEYPAD_DEBOUNCE_SCANS);
+        bounce_to(key, key, bounces);
+        scan(key, rand() % 20);
+        TEST_ASSERT_EQUAL_INT(1, count_events(key, true));
+        bounces = rand() % (2 * KEYPAD_DEBOUNCE_SCANS);
+        bounce_to(key, 0, bounces);
+        scan(0, rand() % 20);
+        TEST_ASSERT_EQUAL_INT(1, count_events(key, false));
+    }
+    keypad_metrics_t metrics;
+    get_keypad_metrics(&metrics);
+    TEST_ASSERT_EQUAL_UINT32(4000, metrics.events);
+    TEST_ASSERT_EQUAL_UINT32(0, metrics.dropped_events);
+}
+
+static void test_full_queue_drops_and_counts(void) {
+    keypad_metrics_t metrics;
+    for (int i = 0; i < KEYPAD_QUEUE_LENGTH; i++) {
+        scan('1', KEYPAD_DEBOUNCE_SCANS);
+        scan(0, KEYPAD_DEBOUNCE_SCANS);
+    }
+    get_keypad_metrics(&metrics);
+    TEST_ASSERT_EQUAL_UINT32(KEYPAD_QUEUE_LENGTH - 1, metrics.events);
+    TEST_ASSERT_EQUAL_UINT32(KEYPAD_QUEUE_LENGTH + 1, metrics.dropped_events);
+    TEST_ASSERT_EQUAL_UINT8(KEYPAD_QUEUE_LENGTH - 1, metrics.maximum_queue_depth);
+    keypad_event_t event;
+    for (int i = 0; i < KEYPAD_QUEUE_LENGTH - 1; i++) {
+        TEST_ASSERT_TRUE(get_keypad_event(&event));
+        TEST_ASSERT_EQUAL(i % 2 == 0, event.pressed);
+    }
+    TEST_ASSERT_FALSE(get_keypad_event(&event));
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_clean_press_and_release);
+    RUN_TEST(test_glitch_shorter_than_the_window_is_rejected);
+    RUN_TEST(test_exactly_one_press_and_release_under_bounce);
+    RUN_TEST(test_full_queue_drops_and_counts);
+    return UNITY_END();
+}
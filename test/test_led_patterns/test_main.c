@@ -0,0 +1,112 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the LED pattern engine's timing against the host's virtual
+ *      clock: the LED timer ISR advances the pattern every LED_TICK_MS, and
+ *      each test checks the LEDs at the times they should change.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "host-hal.h"
+#include "led-patterns.h"
+
+static uint64_t start_us;
+
+static uint8_t leds_at(uint32_t ms) {
+    uint64_t target = start_us + 1000 * (uint64_t) ms;
+    uint64_t now = get_host_time_us();
+    if (target > now) {
+        advance_host_time(target - now);
+    }
+    return (host_led_is_lit(HOST_LEFT) ? LEFT_LED : 0) | (host_led_is_lit(HOST_RIGHT) ? RIGHT_LED : 0);
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    cowpi_deluminate_left_led();
+    cowpi_deluminate_right_led();
+    initialize_led_patterns();
+    start_us = get_host_time_us();
+}
+
+void tearDown(void) {}
+
+// a requested pattern starts on the next tick, and each step lasts its duration
+static void test_bad_try_pattern_blinks_twice_then_stops(void) {
+    TEST_ASSERT_TRUE(start_led_pattern(&BAD_TRY_PATTERN));
+    TEST_ASSERT_TRUE(led_pattern_is_active());
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS - 1));
+    TEST_ASSERT_EQUAL_UINT8(BOTH_LEDS, leds_at(LED_TICK_MS));
+    TEST_ASSERT_EQUAL_UINT8(BOTH_LEDS, leds_at(LED_TICK_MS + 249));
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 250));
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 499));
+    TEST_ASSERT_EQUAL_UINT8(BOTH_LEDS, leds_at(LED_TICK_MS + 500));
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 750));
+    TEST_ASSERT_TRUE(led_pattern_is_active());
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 1000));
+    TEST_ASSERT_FALSE(led_pattern_is_active());
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 2000));
+}
+
+static void test_sequence_pattern_repeats_until_stopped(void) {
+    start_led_pattern(&SEQUENCE_PATTERN);
+    uint8_t const expected[] = {LEFT_LED, RIGHT_LED, BOTH_LEDS, LEDS_OFF};
+    for (uint32_t step = 0; step < 12; step++) {
+        uint32_t entered_ms = LED_TICK_MS + 200 * step;
+        TEST_ASSERT_EQUAL_UINT8(expected[step % 4], leds_at(entered_ms));
+        TEST_ASSERT_EQUAL_UINT8(expected[step % 4], leds_at(entered_ms + 199));
+    }
+    TEST_ASSERT_TRUE(led_pattern_is_active());
+    stop_led_pattern();
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 2400 + LED_TICK_MS));
+    TEST_ASSERT_FALSE(led_pattern_is_active());
+}
+
+// a late tick catches up across as many steps as the elapsed time covers
+static void test_long_elapsed_time_crosses_several_steps(void) {
+    start_led_pattern(&SEQUENCE_PATTERN);
+    advance_led_pattern(0);         // takes the request, entering the first step
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_LEFT));
+    advance_led_pattern(450);       // through RIGHT_LED and 50ms into BOTH_LEDS
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_LEFT));
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_RIGHT));
+    advance_led_pattern(150);       // exactly to the end of BOTH_LEDS
+    TEST_ASSERT_FALSE(host_led_is_lit(HOST_LEFT));
+    TEST_ASSERT_FALSE(host_led_is_lit(HOST_RIGHT));
+}
+
+static void test_pattern_with_zero_duration_step_is_refused(void) {
+    static led_step_t const steps[] = {
+            {.leds = BOTH_LEDS, .duration_ms = 100},
+            {.leds = LEDS_OFF, .duration_ms = 0},
+    };
+    static led_pattern_t const pattern = {.steps = steps, .number_of_steps = 2, .repetitions = 0};
+    TEST_ASSERT_FALSE(start_led_pattern(&pattern));
+    TEST_ASSERT_FALSE(led_pattern_is_active());
+    start_led_pattern(&PULSE_PATTERN);
+    TEST_ASSERT_FALSE(start_led_pattern(&pattern));
+    TEST_ASSERT_EQUAL_UINT8(BOTH_LEDS, leds_at(LED_TICK_MS));
+    TEST_ASSERT_EQUAL_UINT8(LEDS_OFF, leds_at(LED_TICK_MS + 50));
+    TEST_ASSERT_EQUAL_UINT8(BOTH_LEDS, leds_at(LED_TICK_MS + 1000));
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_bad_try_pattern_blinks_twice_then_stops);
+    RUN_TEST(test_sequence_pattern_repeats_until_stopped);
+    RUN_TEST(test_long_elapsed_time_crosses_several_steps);
+    RUN_TEST(test_pattern_with_zero_duration_step_is_refused);
+    return UNITY_END();
+}
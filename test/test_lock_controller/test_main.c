@@ -0,0 +1,106 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the LEDs that the lock controller leaves lit, with the LED
+ *      pattern timer running between loop() iterations as it does on the
+ *      CowPi.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "combination-engine.h"
+#include "detent-delta.h"
+#include "host-hal.h"
+#include "input-events.h"
+#include "led-patterns.h"
+#include "lock-controller.h"
+#include "lock-status.h"
+#include "rotary-encoder.h"
+#include "settings-store.h"
+
+static uint8_t const combination[COMBINATION_LENGTH] = {5, 10, 3};
+static uint8_t const required_passes[COMBINATION_LENGTH] = {COMBOLOCK_REQUIRED_PASSES};
+
+static unsigned detents_to(uint8_t from, uint8_t to, bool clockwise) {
+    unsigned distance = clockwise ? (unsigned) (to + COMBOLOCK_DIAL_POSITIONS - from) % COMBOLOCK_DIAL_POSITIONS
+                                  : (unsigned) (from + COMBOLOCK_DIAL_POSITIONS - to) % COMBOLOCK_DIAL_POSITIONS;
+    return (distance == 0) ? COMBOLOCK_DIAL_POSITIONS : distance;
+}
+
+/* Each number is a turn of its own, as the lock alternates direction; the
+ * first detent of each turn after the first only moves on to the next
+ * number. */
+static void dial(uint8_t const numbers[]) {
+    uint8_t position = 0;
+    for (int i = 0; i < COMBINATION_LENGTH; i++) {
+        int detents = (i > 0) + (int) detents_to(position, numbers[i], i % 2 == 0)
+                      + (required_passes[i] - 1) * COMBOLOCK_DIAL_POSITIONS;
+        inject_detent_delta((i % 2 == 0) ? detents : -detents);
+        control_lock();
+        position = numbers[i];
+    }
+}
+
+static void press_left_button(void) {
+    input_event_t event = {LEFT_BUTTON, INPUT_PRESSED, 0};
+    inject_input_event(&event);
+    control_lock();
+}
+
+void setUp(void) {
+    uint8_t const no_bad_tries = 0;
+    initialize_host_hal();
+    use_host_virtual_time();
+    initialize_settings_store(get_flash_device());
+    write_setting(SETTING_COMBINATION, combination, COMBINATION_LENGTH);
+    write_setting(SETTING_BAD_TRIES, &no_bad_tries, 1);
+    while (service_settings_store()) {}
+    initialize_lock_controller();
+}
+
+void tearDown(void) {}
+
+static void test_unlocking_leaves_the_right_led_lit(void) {
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_LEFT));
+    dial(combination);
+    press_left_button();
+    TEST_ASSERT_EQUAL_STRING("UNLOCKED", get_lock_status().state);
+    // the LED timer ticks several times before loop() runs the lock again
+    advance_host_time(5 * LED_TICK_MS * 1000);
+    TEST_ASSERT_FALSE(host_led_is_lit(HOST_LEFT));
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_RIGHT));
+}
+
+static void test_unlocking_stops_a_bad_try_pattern(void) {
+    uint8_t const wrong[COMBINATION_LENGTH] = {6, 10, 3};
+    dial(wrong);
+    press_left_button();
+    TEST_ASSERT_EQUAL_STRING("LOCKED", get_lock_status().state);
+    TEST_ASSERT_TRUE(led_pattern_is_active());
+    dial(combination);
+    press_left_button();
+    TEST_ASSERT_EQUAL_STRING("UNLOCKED", get_lock_status().state);
+    advance_host_time(5 * LED_TICK_MS * 1000);
+    TEST_ASSERT_FALSE(led_pattern_is_active());
+    control_lock();
+    advance_host_time(5 * LED_TICK_MS * 1000);
+    TEST_ASSERT_FALSE(host_led_is_lit(HOST_LEFT));
+    TEST_ASSERT_TRUE(host_led_is_lit(HOST_RIGHT));
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_unlocking_leaves_the_right_led_lit);
+    RUN_TEST(test_unlocking_stops_a_bad_try_pattern);
+    return UNITY_END();
+}
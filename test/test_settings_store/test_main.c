@@ -0,0 +1,182 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the settings store against the flash simulator: power is cut
+ *      at every flash operation of a run of writes, tearing the record being
+ *      programmed at a different byte each time, and the store is remounted
+ *      from flash as it would be after a power cycle.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <string.h>
+#include <unity.h>
+#include "flash-simulator.h"
+#include "settings-store.h"
+
+#define RECORD_SIZE         (16)        // as in settings-store.c
+#define SLOTS_PER_SECTOR    (4096 / RECORD_SIZE)
+#define NUMBER_OF_SECTORS   (16)
+#define COMBINATION_SIZE    (3)
+// enough writes to compact into the next sector twice
+#define NUMBER_OF_WRITES    (2 * SLOTS_PER_SECTOR + 40)
+
+typedef struct {
+    uint8_t key;
+    uint8_t length;
+    uint8_t value[SETTING_VALUE_SIZE];
+} write_t;
+
+static uint8_t lengths[NUMBER_OF_SETTINGS];
+static uint8_t values[NUMBER_OF_SETTINGS][SETTING_VALUE_SIZE];
+
+// every write changes its setting, so none are skipped as unchanged
+static write_t get_write(int i) {
+    write_t write;
+    if (i % 3 == 2) {
+        write.key = SETTING_BAD_TRIES;
+        write.length = 1;
+        write.value[0] = (uint8_t) i;
+    } else {
+        write.key = SETTING_COMBINATION;
+        write.length = COMBINATION_SIZE;
+        write.value[0] = (uint8_t) i;
+        write.value[1] = (uint8_t) (i >> 8);
+        write.value[2] = (uint8_t) (i * 7);
+    }
+    return write;
+}
+
+static void remount(void) {
+    discard_settings_store_cache();
+    TEST_ASSERT_FALSE(initialize_settings_store(get_flash_device()));
+}
+
+static void assert_setting(uint8_t key, uint8_t length, uint8_t const *value) {
+    uint8_t stored[SETTING_VALUE_SIZE];
+    TEST_ASSERT_EQUAL_INT(length, read_setting(key, stored, SETTING_VALUE_SIZE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(value, stored, length);
+}
+
+/* Writes and persists `write`, and returns false if power was cut first. */
+static bool persist(write_t const *write) {
+    write_setting(write->key, write->value, write->length);
+    while (service_settings_store()) {
+        if (power_is_cut()) {
+            return false;
+        }
+    }
+    return !power_is_cut();
+}
+
+void setUp(void) {
+    reset_flash_simulator();
+    remount();
+    memset(lengths, 0, sizeof(lengths));
+}
+
+void tearDown(void) {}
+
+static void test_settings_survive_a_power_cycle(void) {
+    for (int i = 0; i < NUMBER_OF_WRITES; i++) {
+        write_t write = get_write(i);
+        TEST_ASSERT_TRUE(persist(&write));
+        lengths[write.key] = write.length;
+        memcpy(values[write.key], write.value, write.length);
+    }
+    remount();
+    assert_setting(SETTING_COMBINATION, lengths[SETTING_COMBINATION], values[SETTING_COMBINATION]);
+    assert_setting(SETTING_BAD_TRIES, lengths[SETTING_BAD_TRIES], values[SETTING_BAD_TRIES]);
+}
+
+/* After a cut, the setting being written holds either its old or its new
+ * value, every other setting holds its last persisted value, and the store
+ * carries on from there. */
+static void test_power_cut_at_every_operation_and_byte(void) {
+    bool power_was_cut = true;
+    uint32_t operation;
+    for (operation = 1; power_was_cut; operation++) {
+        // over each 17 operations, a torn program stops at every byte of a record
+        uint32_t bytes = operation % (RECORD_SIZE + 1);
+        setUp();
+        cut_power_after(operation, bytes);
+        int i = 0;
+        write_t write;
+        bool persisted = true;
+        while (persisted && i < NUMBER_OF_WRITES) {
+            write = get_write(i++);
+            persisted = persist(&write);
+            if (persisted) {
+                lengths[write.key] = write.length;
+                memcpy(values[write.key], write.value, write.length);
+            }
+        }
+        power_was_cut = !persisted;
+        if (!power_was_cut) {
+            break;              // past the last operation of the run
+        }
+        restore_power();
+        remount();
+        uint8_t stored[SETTING_VALUE_SIZE];
+        int length = read_setting(write.key, stored, SETTING_VALUE_SIZE);
+        if (length != write.length || memcmp(stored, write.value, write.length) != 0) {
+            if (lengths[write.key]) {
+                assert_setting(write.key, lengths[write.key], values[write.key]);
+            } else {
+                TEST_ASSERT_EQUAL_INT(-1, length);
+            }
+        }
+        uint8_t other = (write.key == SETTING_COMBINATION) ? SETTING_BAD_TRIES : SETTING_COMBINATION;
+        if (lengths[other]) {
+            assert_setting(other, lengths[other], values[other]);
+        }
+        // the write in flight went with the power, so carry on from what was kept
+        lengths[write.key] = (length < 0) ? 0 : (uint8_t) length;
+        memcpy(values[write.key], stored, lengths[write.key]);
+        for (; i < NUMBER_OF_WRITES; i++) {
+            write = get_write(i);
+            TEST_ASSERT_TRUE(persist(&write));
+            lengths[write.key] = write.length;
+            memcpy(values[write.key], write.value, write.length);
+        }
+        remount();
+        assert_setting(SETTING_COMBINATION, lengths[SETTING_COMBINATION], values[SETTING_COMBINATION]);
+        assert_setting(SETTING_BAD_TRIES, lengths[SETTING_BAD_TRIES], values[SETTING_BAD_TRIES]);
+    }
+    TEST_ASSERT_GREATER_THAN_UINT32(NUMBER_OF_WRITES, operation);
+}
+
+/* Sectors are used round-robin, so no sector is erased more than once more
+ * than any other. */
+static void test_erases_are_spread_over_every_sector(void) {
+    uint32_t fewest = 0;
+    for (int i = 0; i < 3 * NUMBER_OF_SECTORS * SLOTS_PER_SECTOR; i++) {
+        write_t write = get_write(i);
+        TEST_ASSERT_TRUE(persist(&write));
+        fewest = UINT32_MAX;
+        uint32_t most = 0;
+        for (uint32_t sector = 0; sector < NUMBER_OF_SECTORS; sector++) {
+            uint32_t erases = get_sector_erase_count(sector);
+            fewest = (erases < fewest) ? erases : fewest;
+            most = (erases > most) ? erases : most;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(fewest + 1, most);
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, fewest);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_settings_survive_a_power_cycle);
+    RUN_TEST(test_power_cut_at_every_operation_and_byte);
+    RUN_TEST(test_erases_are_spread_over_every_sector);
+    return UNITY_END();
+}
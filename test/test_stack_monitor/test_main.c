@@ -0,0 +1,113 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the stack monitor's paint counting, and that its high-water
+ *      mark and guard region follow what the host's main stack really used.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <alloca.h>
+#include <unity.h>
+#include "flight-recorder.h"
+#include "host-hal.h"
+#include "stack-monitor.h"
+
+/* The frames between the top of the painted block and a callee's alloca()
+ * block blur the marks by up to this much. */
+#define SLACK_BYTES         (1024)
+
+static flight_event_t events[FLIGHT_RECORDER_LENGTH];
+
+/* Writes to `bytes` of stack below this function's frame. */
+static void __attribute__((noinline)) use_stack(size_t bytes) {
+    uint8_t volatile *block = alloca(bytes);
+    for (size_t i = 0; i < bytes; i++) {
+        block[i] = 0;
+    }
+}
+
+static int count_overflow_events(void) {
+    int count = 0;
+    int length = get_flight_events(events);
+    for (int i = 0; i < length; i++) {
+        if (events[i].type == FLIGHT_STACK_OVERFLOW && events[i].a == STACK_MAIN) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    discard_flight_recorder();
+    initialize_flight_recorder();
+}
+
+void tearDown(void) {}
+
+static void test_painted_words_are_counted_from_the_bottom(void) {
+    uint32_t stack[64];
+    paint_stack(stack, stack + 64);
+    TEST_ASSERT_EQUAL_UINT32(64, count_painted_words(stack, stack + 64));
+    stack[40] = 0;
+    TEST_ASSERT_EQUAL_UINT32(40, count_painted_words(stack, stack + 64));
+    // a word above the deepest use that happens to match the paint changes nothing
+    stack[50] = 0;
+    stack[45] = STACK_PAINT;
+    TEST_ASSERT_EQUAL_UINT32(40, count_painted_words(stack, stack + 64));
+    stack[0] = ~STACK_PAINT;
+    TEST_ASSERT_EQUAL_UINT32(0, count_painted_words(stack, stack + 64));
+}
+
+static void test_high_water_mark_follows_the_deepest_use(void) {
+    initialize_stack_monitor();
+    TEST_ASSERT_EQUAL_UINT32(STACK_HOST_DEPTH, get_stack_usage(STACK_MAIN).size_bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stack_usage(STACK_INTERRUPT).size_bytes);
+    use_stack(16384);
+    scan_stacks();
+    uint32_t mark = get_stack_usage(STACK_MAIN).high_water_bytes;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(16384 - SLACK_BYTES, mark);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(16384 + SLACK_BYTES, mark);
+    // a shallower use leaves the mark where it was
+    use_stack(1024);
+    scan_stacks();
+    TEST_ASSERT_EQUAL_UINT32(mark, get_stack_usage(STACK_MAIN).high_water_bytes);
+    use_stack(40000);
+    scan_stacks();
+    mark = get_stack_usage(STACK_MAIN).high_water_bytes;
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(40000 - SLACK_BYTES, mark);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(40000 + SLACK_BYTES, mark);
+    TEST_ASSERT_FALSE(get_stack_usage(STACK_MAIN).overflowed);
+    TEST_ASSERT_EQUAL_INT(0, count_overflow_events());
+}
+
+static void test_reaching_the_guard_region_is_recorded_once(void) {
+    initialize_stack_monitor();
+    use_stack(STACK_HOST_DEPTH + SLACK_BYTES);
+    scan_stacks();
+    stack_usage_t usage = get_stack_usage(STACK_MAIN);
+    TEST_ASSERT_TRUE(usage.overflowed);
+    TEST_ASSERT_EQUAL_UINT32(STACK_HOST_DEPTH, usage.high_water_bytes);
+    TEST_ASSERT_EQUAL_INT(1, count_overflow_events());
+    scan_stacks();
+    TEST_ASSERT_EQUAL_INT(1, count_overflow_events());
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_painted_words_are_counted_from_the_bottom);
+    RUN_TEST(test_high_water_mark_follows_the_deepest_use);
+    RUN_TEST(test_reaching_the_guard_region_is_recorded_once);
+    return UNITY_END();
+}
@@ -0,0 +1,213 @@
+/**************************************************************************//**
+ *
+ * @file test_main.c
+ *
+ * @author Nick Goertzen
+ * @author Nolan Hill
+ *
+ * @brief Tests the task scheduler's waits against a virtual clock, and that
+ *      a tickless loop, sleeping in wait_for_work() until the time that
+ *      run_tasks() returns, resumes each delayed task when its delay ends.
+ *
+ ******************************************************************************/
+
+/*
+ * ComboLock GroupLab assignment and starter code (c) 2022-24 Christopher A. Bohn
+ * ComboLock solution (c) the above-named students
+ */
+
+#include <CowPi.h>
+#include <unity.h>
+#include "host-hal.h"
+#include "pending-work.h"
+#include "task-scheduler.h"
+#include "time-service.h"
+
+#define NO_WAKE_US          ((uint32_t) INT32_MAX)
+#define MAXIMUM_RUNS        (16)
+
+static uint32_t delay_us;
+static uint32_t delayed_runs[MAXIMUM_RUNS];
+static int number_of_delayed_runs;
+static int awaiting_runs;
+static int yielding_runs;
+static int ending_runs;
+static int settled_runs;
+
+static task_status_t delaying_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        if (number_of_delayed_runs < MAXIMUM_RUNS) {
+            delayed_runs[number_of_delayed_runs++] = get_task_time();
+        }
+        TASK_DELAY(task, delay_us);
+    }
+    TASK_END(task);
+}
+
+static task_status_t awaiting_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        awaiting_runs++;
+        TASK_AWAIT_EVENTS(task, WORK_KEYPAD, 5000);
+    }
+    TASK_END(task);
+}
+
+static task_status_t yielding_task(task_t *task) {
+    TASK_BEGIN(task);
+    while (true) {
+        yielding_runs++;
+        TASK_YIELD(task);
+    }
+    TASK_END(task);
+}
+
+static task_status_t ending_task(task_t *task) {
+    TASK_BEGIN(task);
+    ending_runs++;
+    TASK_DELAY(task, 1000);
+    ending_runs++;
+    TASK_END(task);
+}
+
+static task_status_t settling_task(task_t *task) {
+    TASK_BEGIN(task);
+    TASK_DELAY(task, 1000);
+    while (true) {
+        settled_runs++;
+        TASK_YIELD(task);
+    }
+    TASK_END(task);
+}
+
+void setUp(void) {
+    initialize_host_hal();
+    use_host_virtual_time();
+    initialize_task_scheduler();
+    delay_us = 3000;
+    number_of_delayed_runs = 0;
+    awaiting_runs = 0;
+    yielding_runs = 0;
+    ending_runs = 0;
+    settled_runs = 0;
+}
+
+void tearDown(void) {}
+
+static void test_delay_ends_on_time_and_sets_the_wake_time(void) {
+    start_task(delaying_task, "delay", 0);
+    TEST_ASSERT_EQUAL_UINT32(1000 + 3000, run_tasks(0, 1000));
+    TEST_ASSERT_EQUAL_UINT32(4000, run_tasks(0, 3999));
+    TEST_ASSERT_EQUAL_INT(1, number_of_delayed_runs);
+    TEST_ASSERT_EQUAL_UINT32(7000, run_tasks(0, 4000));
+    TEST_ASSERT_EQUAL_INT(2, number_of_delayed_runs);
+    TEST_ASSERT_EQUAL_UINT32(4000, delayed_runs[1]);
+}
+
+static void test_earliest_wake_time_is_returned(void) {
+    start_task(delaying_task, "delay", 0);
+    start_task(awaiting_task, "await", 0);
+    start_task(yielding_task, "yield", 0);
+    TEST_ASSERT_EQUAL_UINT32(3000, run_tasks(0, 0));
+    delay_us = 8000;
+    TEST_ASSERT_EQUAL_UINT32(5000, run_tasks(0, 3000));     // the delay moved past the timeout
+    TEST_ASSERT_EQUAL_INT(2, yielding_runs);
+}
+
+static void test_events_end_a_wait_before_its_timeout(void) {
+    start_task(awaiting_task, "await", 0);
+    run_tasks(0, 0);
+    run_tasks(WORK_DETENT, 100);
+    TEST_ASSERT_EQUAL_INT(1, awaiting_runs);
+    TEST_ASSERT_EQUAL_UINT32(200 + 5000, run_tasks(WORK_KEYPAD, 200));
+    TEST_ASSERT_EQUAL_INT(2, awaiting_runs);
+    // the events were consumed along with the wait
+    run_tasks(0, 300);
+    TEST_ASSERT_EQUAL_INT(2, awaiting_runs);
+    run_tasks(0, 5200);
+    TEST_ASSERT_EQUAL_INT(3, awaiting_runs);
+}
+
+static void test_only_timed_waits_set_a_wake_time(void) {
+    start_task(yielding_task, "yield", 0);
+    TEST_ASSERT_EQUAL_UINT32(500 + NO_WAKE_US, run_tasks(0, 500));
+    start_task(settling_task, "settle", 0);
+    TEST_ASSERT_EQUAL_UINT32(1500, run_tasks(0, 500));
+    TEST_ASSERT_EQUAL_UINT32(1500 + NO_WAKE_US, run_tasks(0, 1500));
+    TEST_ASSERT_EQUAL_INT(1, settled_runs);
+    // a delay that has ended no longer counts, even once the clock makes its time look near again
+    uint32_t later = 1500 + 0x80000000u + 1000;
+    TEST_ASSERT_EQUAL_UINT32(later + NO_WAKE_US, run_tasks(0, later));
+}
+
+static void test_ended_task_is_removed(void) {
+    start_task(ending_task, "end", 0);
+    start_task(yielding_task, "yield", 0);
+    run_tasks(0, 0);
+    run_tasks(0, 1000);
+    TEST_ASSERT_EQUAL_INT(2, ending_runs);
+    scheduler_metrics_t before = get_scheduler_metrics();
+    run_tasks(0, 2000);
+    scheduler_metrics_t after = get_scheduler_metrics();
+    TEST_ASSERT_EQUAL_INT(2, ending_runs);
+    TEST_ASSERT_EQUAL_INT(3, yielding_runs);
+    TEST_ASSERT_EQUAL_UINT32(1, after.resumptions - before.resumptions);
+}
+
+static void test_delay_across_the_clock_wrapping(void) {
+    start_task(delaying_task, "delay", 0);
+    uint32_t start = UINT32_MAX - 1000;
+    TEST_ASSERT_EQUAL_UINT32(start + 3000, run_tasks(0, start));
+    run_tasks(0, UINT32_MAX);
+    TEST_ASSERT_EQUAL_INT(1, number_of_delayed_runs);
+    run_tasks(0, start + 3000);
+    TEST_ASSERT_EQUAL_INT(2, number_of_delayed_runs);
+    TEST_ASSERT_EQUAL_UINT32(1999, delayed_runs[1]);
+}
+
+/* With no ISR posting anything, only the wake-up alarm runs the loop, so
+ * every delay must end exactly on time; a 250 ms delay is split into sleeps
+ * of at most WORK_TICK_PERIOD_MS. */
+static uint32_t run_loop_pass(uint32_t wake_us) {
+    uint32_t events = wait_for_work(wake_us);
+    return run_tasks(events, (uint32_t) get_time_us());
+}
+
+static void test_tickless_loop_wakes_at_each_delay(void) {
+    initialize_pending_work();
+    start_task(delaying_task, "delay", 0);
+    delay_us = 7000;
+    uint32_t wake_us = 0;
+    int passes = 0;
+    while (number_of_delayed_runs < 6) {
+        wake_us = run_loop_pass(wake_us);
+        passes++;
+    }
+    TEST_ASSERT_EQUAL_INT(6, passes);
+    for (int i = 1; i < 6; i++) {
+        TEST_ASSERT_EQUAL_UINT32(7000, delayed_runs[i] - delayed_runs[i - 1]);
+    }
+    delay_us = 250000;
+    wake_us = run_loop_pass(wake_us);
+    uint32_t start = delayed_runs[6];
+    passes = 0;
+    while (number_of_delayed_runs < 8) {
+        wake_us = run_loop_pass(wake_us);
+        passes++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(250000, delayed_runs[7] - start);
+    TEST_ASSERT_EQUAL_INT(250000 / (WORK_TICK_PERIOD_MS * 1000) + 1, passes);
+}
+
+int main(int argc, char *argv[]) {
+    UNITY_BEGIN();
+    RUN_TEST(test_delay_ends_on_time_and_sets_the_wake_time);
+    RUN_TEST(test_earliest_wake_time_is_returned);
+    RUN_TEST(test_events_end_a_wait_before_its_timeout);
+    RUN_TEST(test_only_timed_waits_set_a_wake_time);
+    RUN_TEST(test_ended_task_is_removed);
+    RUN_TEST(test_delay_across_the_clock_wrapping);
+    RUN_TEST(test_tickless_loop_wakes_at_each_delay);
+    return UNITY_END();
+}